@@ -4,6 +4,7 @@
 #include "FollowOpsemTails.h"
 #include "FilterAllActions.h"
 #include "Graph.h"
+#include "VisitedEdges.h"
 #include "utils/macros.h"
 #include "iomanip_dotfile.h"
 
@@ -47,7 +48,7 @@ std::ostream& operator<<(std::ostream& os, Action const& action)
   return os;
 }
 
-Action::Action(id_type next_node_id, ThreadPtr const& thread, ast::tag variable) : m_id(next_node_id), m_thread(thread), m_exists(true)
+Action::Action(id_type next_node_id, ThreadPtr const& thread, ast::tag variable) : m_id(next_node_id), m_thread(thread), m_exists(true), m_consume_acts_as_acquire(false)
 {
 #ifdef CWDEBUG
   locations_type const& locations{Context::instance().locations()};
@@ -113,6 +114,12 @@ void Action::add_edge_to(EdgeType edge_type, Action* head_node, boolean::Express
   Dout(*dc::edge[edge_type], "ADDED EDGE " << *new_edge);
   if (edge_type == edge_sb || edge_type == edge_asw)
     head_node->update_exists();
+  else if (edge_type == edge_dd)
+  {
+    // Carries-a-dependency-to is transitive.
+    head_node->m_dependency_sources.add(*this);
+    head_node->m_dependency_sources.add(m_dependency_sources);
+  }
 }
 
 void Action::delete_edge_to(EdgeType edge_type, Action* head_node)
@@ -309,7 +316,7 @@ bool Action::matches(NodeRequestedType const& requested_type, boolean::Expressio
 }
 
 //static
-void Action::initialize_post_opsem(Graph const& graph, TopologicalOrderedActions& topological_ordered_actions)
+int Action::initialize_post_opsem(Graph const& graph, TopologicalOrderedActions& topological_ordered_actions)
 {
   DoutEntering(dc::notice, "Action::initialize_post_opsem(...)");
   // Number all actions in a smart way.
@@ -336,13 +343,13 @@ void Action::initialize_post_opsem(Graph const& graph, TopologicalOrderedActions
         if (!action->m_sequence_number.undefined())
           return true;
         for (auto&& end_point : action->m_end_points)
-          if (end_point.type() == tail && end_point.edge()->is_opsem())
+          if (end_point.type() == tail && end_point.edge()->is_sbw())
           {
             end_point.other_node()->m_prior_actions.add(action->m_prior_actions);
             end_point.other_node()->m_prior_actions.add(*action);
           }
         for (auto&& end_point : action->m_end_points)
-          if (end_point.type() == head && end_point.edge()->is_opsem())
+          if (end_point.type() == head && end_point.edge()->is_sbw())
           {
             if (end_point.other_node()->m_sequence_number.undefined())
             {
@@ -358,12 +365,29 @@ void Action::initialize_post_opsem(Graph const& graph, TopologicalOrderedActions
         return false;
       }
   );
+  // A consume read that carries a dependency to everything that is sequenced after it
+  // is, for the purpose of happens-before, as good as an acquire read.
+  for (Action* action : topological_ordered_actions)
+    if (action->is_consume())
+    {
+      action->m_consume_acts_as_acquire = std::all_of(topological_ordered_actions.begin(), topological_ordered_actions.end(),
+          [action](Action const* later_action) { return !action->is_sequenced_before(*later_action) || action->carries_a_dependency_to(*later_action); });
+      Dout(dc::notice, *action << (action->m_consume_acts_as_acquire ? " acts" : " does not act") << " as acquire.");
+    }
+  // Give every sb and asw edge a dense index, in topological order of their tail.
+  // The dd and cd edges are never followed by the traversals that use this index (see VisitedEdges).
+  int opsem_index = 0;
+  for (Action* action : topological_ordered_actions)
+    for (auto&& end_point : action->m_end_points)
+      if (end_point.type() == tail && end_point.edge()->is_sbw())
+        end_point.edge()->set_opsem_index(opsem_index++);
+  return opsem_index;
 }
 
-bool Action::is_fully_visited(int visited_generation, Action* read_node) const
+bool Action::is_fully_visited(VisitedEdges const& visited_edges, int visited_generation, Action* read_node) const
 {
   for (auto&& end_point : m_end_points)
-    if (end_point.type() == tail && end_point.edge()->is_opsem())
+    if (end_point.type() == tail && end_point.edge()->is_sbw())
     {
       if (end_point.other_node() != read_node && !end_point.other_node()->is_sequenced_before(*read_node))
       {
@@ -371,7 +395,7 @@ bool Action::is_fully_visited(int visited_generation, Action* read_node) const
             " is skipped because that node is not sequenced before the Read node " << read_node->name() << '.');
         continue;
       }
-      if (!end_point.edge()->is_visited(visited_generation))
+      if (!visited_edges.is_visited(end_point.edge(), visited_generation))
       {
         Dout(dc::visited, "The edge to " << end_point.other_node()->name() << " wasn't visited yet.");
         return false;
@@ -380,14 +404,14 @@ bool Action::is_fully_visited(int visited_generation, Action* read_node) const
   return true;
 }
 
-boolean::Expression Action::calculate_path_condition(int visited_generation, Action* read_node) const
+boolean::Expression Action::calculate_path_condition(VisitedEdges const& visited_edges, int visited_generation, Action* read_node) const
 {
   DoutEntering(dc::visited, "Action::calculate_path_condition('" << read_node->name() << "') [this = " << *this << "].");
   boolean::Expression branch_path_condition[2] = { true, true };
   boolean::Product branch_condition;
   bool have_branch = false;
   for (auto&& end_point : m_end_points)
-    if (end_point.type() == tail && end_point.edge()->is_opsem() &&
+    if (end_point.type() == tail && end_point.edge()->is_sbw() &&
         (end_point.other_node() == read_node || end_point.other_node()->is_sequenced_before(*read_node)))
     {
       // Opsem edges have edge conditions that are products.
@@ -401,15 +425,15 @@ boolean::Expression Action::calculate_path_condition(int visited_generation, Act
         have_branch = true;
         branch_condition = edge_condition;
         Dout(dc::visited, "Visited-condition of " << end_point.other_node()->name() << " <-" << edge_name(end_point.edge_type()) << "- " << name() << " is " <<
-            end_point.edge()->visited_condition(visited_generation) << '.');
-        branch_path_condition[0] = end_point.edge()->visited_condition(visited_generation).copy();
+            visited_edges.visited_condition(end_point.edge(), visited_generation) << '.');
+        branch_path_condition[0] = visited_edges.visited_condition(end_point.edge(), visited_generation).copy();
         Dout(dc::visited, "Initialized branch_path_condition[0] with " << branch_path_condition[0] << " and branch_path_condition[1] with 1.");
         continue;
       }
       int branch = (!have_branch || edge_condition == branch_condition) ? 0 : 1;
-      branch_path_condition[branch] = branch_path_condition[branch].times(end_point.edge()->visited_condition(visited_generation));
+      branch_path_condition[branch] = branch_path_condition[branch].times(visited_edges.visited_condition(end_point.edge(), visited_generation));
       Dout(dc::visited, "Visited-condition of " << end_point.other_node()->name() << " <-" << edge_name(end_point.edge_type()) << "- " << name() << " is " <<
-          end_point.edge()->visited_condition(visited_generation) << "; branch_path_condition[" << branch << "] is now " << branch_path_condition[branch] << '.');
+          visited_edges.visited_condition(end_point.edge(), visited_generation) << "; branch_path_condition[" << branch << "] is now " << branch_path_condition[branch] << '.');
     }
   return (have_branch && !branch_path_condition[1].is_one()) ? branch_path_condition[0] + branch_path_condition[1] : branch_path_condition[0].copy();
 }
@@ -12,6 +12,7 @@
 #include <memory>
 
 class Graph;
+class VisitedEdges;
 
 // Base class for all nodes in the graph.
 class Action
@@ -46,6 +47,7 @@ class Action
   end_points_type m_end_points;                 // End points of all connected edges.
   boolean::Expression m_exists;                 // Whether or not this node exists. Set to true until an incoming edge is added and then updated.
   SBNodePresence m_connected;                   // Signifies existing sequenced-before relationships.
+  ActionSet m_dependency_sources;               // Reads that carry a dependency to this action through Data-Dependency edges.
   static boolean::Expression const s_expression_one;
   static boolean::Product const s_product_one;
 
@@ -53,6 +55,7 @@ class Action
   SequenceNumber m_sequence_number; // Some over all ordering number (n) such that if A--sb/asw-->B than n_A < n_B.
   ActionSet m_prior_actions;                    // Actions from which this action is reachable through SB and ASW edges.
   int m_read_from_loop_index;                   // The index into the ... array
+  bool m_consume_acts_as_acquire;               // Set for a consume read that carries a dependency to every action sequenced after it.
 
  public:
   Action() = default;
@@ -103,19 +106,19 @@ class Action
     return nullptr;
   }
 
-  template<class FOLLOW, class FILTER>
+  template<class FOLLOW, class FILTER, class IF_FOUND>     // bool IF_FOUND::operator()(Action*) const must exist.
   void for_actions_no_condition(
     FOLLOW& follow,
     FILTER filter,
-    std::function<bool(Action*)> const& if_found) const;
+    IF_FOUND const& if_found) const;
 
   // Returns an expression that is true when something was found.
-  template<class FOLLOW, class FILTER>     // bool FOLLOW::operator()(EndPoint const&) and FILTER::operator()(Action const&) must exist.
+  template<class FOLLOW, class FILTER, class IF_FOUND>     // bool FOLLOW::operator()(EndPoint const&), FILTER::operator()(Action const&) and IF_FOUND::operator()(Action*, boolean::Expression&&) const must exist.
   void for_actions(
     FOLLOW& follow,     // Follow each EndPoint when `bool FOLLOW::operator()(EndPoint const&)` returns true.
     FILTER filter,      // Call if_found() for each action found after following an edge when `bool FILTER::operator()(Action const&)` returns true.
                         // Call for_actions() recursively unless if_found returned true (so if if_found wasn't called, then always call for_actions).
-    std::function<bool(Action*, boolean::Expression&&)> const& if_found,
+    IF_FOUND const& if_found,
     boolean::Expression const& path_condition) const;   // The product of the edge conditions encountered.
 
   // Accessors.
@@ -129,13 +132,14 @@ class Action
   boolean::Expression const& exists() const { return m_exists; }
 
   // Post opsem stuff.
-  static void initialize_post_opsem(Graph const& graph, TopologicalOrderedActions& topological_ordered_actions);
+  // Returns the number of opsem edges.
+  static int initialize_post_opsem(Graph const& graph, TopologicalOrderedActions& topological_ordered_actions);
   SequenceNumber sequence_number() const { return m_sequence_number; }
   bool is_sequenced_before(Action const& action) const { return action.m_prior_actions.includes(*this); }
   void set_read_from_loop_index(int read_from_loop_index) { m_read_from_loop_index = read_from_loop_index; }
   int get_read_from_loop_index() const { return m_read_from_loop_index; }
-  bool is_fully_visited(int visited_generation, Action* read_node) const;
-  boolean::Expression calculate_path_condition(int visited_generation, Action* read_node) const;
+  bool is_fully_visited(VisitedEdges const& visited_edges, int visited_generation, Action* read_node) const;
+  boolean::Expression calculate_path_condition(VisitedEdges const& visited_edges, int visited_generation, Action* read_node) const;
   bool is_acquire() const
   {
     if (!is_atomic_read())
@@ -143,6 +147,10 @@ class Action
     std::memory_order mo = read_memory_order();
     return mo == std::memory_order_acquire || mo == std::memory_order_acq_rel || mo == std::memory_order_seq_cst;
   }
+  bool is_consume() const
+  {
+    return is_atomic_read() && read_memory_order() == std::memory_order_consume;
+  }
   bool is_release() const
   {
     if (!is_atomic_write())
@@ -151,6 +159,17 @@ class Action
     return mo == std::memory_order_release || mo == std::memory_order_acq_rel || mo == std::memory_order_seq_cst;
   }
 
+  // Return true if this action carries a dependency to action.
+  // Only dependencies through values (registers, expressions and RMW's) are known after opsem;
+  // carrying a dependency through memory depends on the rf edges of the candidate.
+  bool carries_a_dependency_to(Action const& action) const { return action.m_dependency_sources.includes(*this); }
+
+  // Return true if a release that this read reads from (or that heads the release sequence that it reads from)
+  // happens before every action sequenced after this read. That is the case for an acquire read, but also for
+  // a consume read that carries a dependency to all of those actions: then the release is dependency-ordered
+  // before each of them. Only valid after initialize_post_opsem.
+  bool acts_as_acquire() const { return is_acquire() || m_consume_acts_as_acquire; }
+
   virtual Kind kind() const = 0;
   virtual bool is_second_mutex_access() const { return false; }
   virtual std::string type() const = 0;
@@ -7,11 +7,11 @@ extern channel_ct for_action;
 NAMESPACE_DEBUG_CHANNELS_END
 #endif
 
-template<class FOLLOW, class FILTER>
+template<class FOLLOW, class FILTER, class IF_FOUND>
 void Action::for_actions_no_condition(
   FOLLOW& follow,
   FILTER filter,
-  std::function<bool(Action*)> const& if_found) const
+  IF_FOUND const& if_found) const
 {
   DoutEntering(dc::for_action, "Action::for_actions_no_condition<" <<
       type_info_of<FOLLOW>().demangled_name() << ", " <<
@@ -38,11 +38,11 @@ void Action::for_actions_no_condition(
     }
 }
 
-template<class FOLLOW, class FILTER>
+template<class FOLLOW, class FILTER, class IF_FOUND>
 void Action::for_actions(
   FOLLOW& follow,
   FILTER filter,
-  std::function<bool(Action*, boolean::Expression&&)> const& if_found,
+  IF_FOUND const& if_found,
   boolean::Expression const& path_condition) const
 {
   DoutEntering(dc::for_action, "Action::for_actions<" <<
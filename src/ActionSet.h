@@ -18,4 +18,7 @@ class ActionSet
 
   // Return true if action is element of the set.
   inline bool includes(Action const& action) const;
+
+  // Return true if this set and action_set have at least one element in common.
+  bool intersects(ActionSet const& action_set) const { return (m_actions & action_set.m_actions).any(); }
 };
@@ -0,0 +1,9 @@
+#include "sys.h"
+#include "AllocationCounter.h"
+
+namespace allocation_counter {
+
+bool enabled;                   // Constant initialized (false) before any dynamic initialization can set it.
+thread_local Counts counts;
+
+} // namespace allocation_counter
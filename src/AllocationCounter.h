@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Count the calls to (and the bytes requested from) the global operator new.
+//
+// The library only provides allocation_counter::counts. Programs that want
+// allocations to be counted add AllocationCounterNew.cxx to their sources:
+// it replaces the global operator new and operator delete by versions that
+// call malloc and free, counting every allocation of the calling thread in
+// allocation_counter::counts, and sets allocation_counter::enabled. This is
+// how cppmem::analyze attributes allocations to its phases (see cppmem::Profile),
+// without replacing the allocator of every program that links with the library.
+//
+// In debug builds libcwd already replaces operator new, so then nothing is
+// counted and allocation_counter::enabled remains false.
+//
+namespace allocation_counter {
+
+struct Counts
+{
+  uint64_t allocations;         // The number of calls to operator new.
+  uint64_t bytes;               // The total number of bytes requested.
+};
+
+extern bool enabled;            // Set if the global operator new counts allocations.
+extern thread_local Counts counts;
+
+} // namespace allocation_counter
@@ -0,0 +1,45 @@
+#include "sys.h"
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+// Only link this into programs, never into a library (see AllocationCounter.h).
+
+#ifndef CWDEBUG
+
+namespace {
+
+struct Enable
+{
+  Enable() { allocation_counter::enabled = true; }
+} enable;
+
+} // namespace
+
+// All other (non-aligned) forms of operator new call this one, and all
+// forms of operator delete end up in the unsized operator delete.
+
+void* operator new(std::size_t size)
+{
+  ++allocation_counter::counts.allocations;
+  allocation_counter::counts.bytes += size;
+  if (size == 0)
+    size = 1;
+  for (;;)
+  {
+    void* ptr = std::malloc(size);
+    if (ptr)
+      return ptr;
+    std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+#endif // CWDEBUG
@@ -0,0 +1,30 @@
+#include "sys.h"
+#include "AnalysisSession.h"
+
+AnalysisSession::AnalysisSession() : m_symbols(new parser::Symbols), m_own_symbols(true), m_previous_session(s_current)
+{
+  make_current(this);
+}
+
+AnalysisSession::AnalysisSession(parser::Symbols& symbols) : m_symbols(&symbols), m_own_symbols(false), m_previous_session(s_current)
+{
+  make_current(this);
+}
+
+AnalysisSession::~AnalysisSession()
+{
+  ASSERT(s_current == this);
+  make_current(m_previous_session);
+  if (m_own_symbols)
+    delete m_symbols;
+}
+
+void AnalysisSession::make_current(AnalysisSession* session)
+{
+  s_current = session;
+  Context::s_instance = session ? &session->m_context : nullptr;
+  parser::Symbols::s_instance = session ? session->m_symbols : nullptr;
+}
+
+//static
+thread_local AnalysisSession* AnalysisSession::s_current;
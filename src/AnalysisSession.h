@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Graph.h"
+#include "Context.h"
+#include "Symbols_parser.h"
+#include "TagCompare.h"
+#include "ast.h"
+#include <map>
+
+// All state of the analysis of one test.
+//
+// Constructing an AnalysisSession makes it the current session of the
+// calling thread: Context::instance(), parser::Symbols::instance() and
+// AnalysisSession::current() then return the objects owned by this
+// session. Destructing it makes the previous session current again.
+//
+// Hence every analysis starts with a clean slate, and different threads
+// can each run their own analysis. The boolean variables of the session
+// are taken from BooleanVariables, by the (per session) ids of the
+// Conditional and ReleaseSequence objects.
+//
+// The parser symbol tables can be borrowed from a cppmem::Parser that is
+// reused for many analyses, because its grammar refers to those tables.
+//
+class AnalysisSession
+{
+ public:
+  using functions_type = std::map<ast::tag, ast::function, TagCompare>;
+
+ private:
+  parser::Symbols* const m_symbols;             // The symbol tables of the parser.
+  bool const m_own_symbols;                     // Set if m_symbols is owned by this session, rather than by a cppmem::Parser.
+  Graph m_graph;                                // The graph with all actions.
+  Context m_context;                            // The state of the opsem generation (refers to m_graph).
+  functions_type m_functions;                   // All function definitions.
+  AnalysisSession* m_previous_session;          // The session that was current before this one.
+
+  static thread_local AnalysisSession* s_current;       // The current session of this thread.
+
+ public:
+  AnalysisSession();
+  // Use the symbol tables of a reused parser.
+  explicit AnalysisSession(parser::Symbols& symbols);
+  ~AnalysisSession();
+
+  AnalysisSession(AnalysisSession const&) = delete;
+  AnalysisSession& operator=(AnalysisSession const&) = delete;
+
+  // Return the current session of this thread.
+  static AnalysisSession& current() { ASSERT(s_current); return *s_current; }
+
+  // Accessors.
+  parser::Symbols& symbols() { return *m_symbols; }
+  Graph& graph() { return m_graph; }
+  Context& context() { return m_context; }
+  functions_type& functions() { return m_functions; }
+
+ private:
+  void make_current(AnalysisSession* session);
+};
@@ -0,0 +1,26 @@
+#include "sys.h"
+#include "BooleanVariables.h"
+#include "utils/AIAlert.h"
+#include <string>
+
+BooleanVariables::BooleanVariables()
+{
+  m_variables.reserve(number_of_kinds * max_ids);
+  // Create the variables of all conditionals first, so that they are ordered before those of the
+  // release sequences; which is also the order in which a test creates them.
+  for (int kind = 0; kind < number_of_kinds; ++kind)
+    for (int id = 0; id < max_ids; ++id)
+      m_variables.push_back(boolean::Context::instance().create_variable(std::string(1, 'A' + id)));      // Same as the id_name() of the object.
+}
+
+//static
+boolean::Variable BooleanVariables::get(Kind kind, int id)
+{
+  // Initialization of a function-local static is thread-safe.
+  static BooleanVariables const s_boolean_variables;
+
+  if (id >= max_ids)
+    THROW_ALERT("Too many [KIND] (more than [MAX])",
+        AIArgs("[KIND]", kind == conditional ? "conditionals" : "release sequences")("[MAX]", max_ids));
+  return s_boolean_variables.m_variables[kind * max_ids + id];
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "boolean-expression/BooleanExpression.h"
+#include <vector>
+
+// The boolean variables of the Conditional and ReleaseSequence objects of a test.
+//
+// Variables are created in boolean::Context, a singleton of the boolean-expression
+// library that is shared by the whole process, is not thread-safe and never forgets
+// a variable. Therefore all variables that a test can use are created once, before
+// the first one is needed, and every AnalysisSession uses the same variables again:
+// the n-th Conditional (and the n-th ReleaseSequence) of every test gets the same
+// variable. Expressions of different sessions are never combined, so sharing the
+// variables is harmless. After that boolean::Context is only read: concurrent
+// sessions don't race on it, and the number of variables doesn't grow with the
+// number of tests that a process analyzes.
+//
+// A product is a 64-bit mask, which limits the number of variables to 64;
+// these are split evenly between conditionals and release sequences. A test that
+// needs more throws an AIAlert::Error.
+//
+class BooleanVariables
+{
+ public:
+  enum Kind
+  {
+    conditional,
+    release_sequence,
+    number_of_kinds
+  };
+
+  static constexpr int max_ids = 32;                    // The maximum number of variables per kind.
+
+ private:
+  std::vector<boolean::Variable> m_variables;           // All variables, max_ids per kind, in the order of Kind.
+
+  BooleanVariables();
+
+ public:
+  // Return the variable of the object of kind `kind' with id `id' (the id of the first object of a test is 0).
+  static boolean::Variable get(Kind kind, int id);
+};
@@ -13,11 +13,12 @@ void BranchInfo::print_on(std::ostream& os) const
     '}';
 }
 
-BranchInfo::BranchInfo(ConditionalBranch const& conditional_branch) :
+BranchInfo::BranchInfo(ConditionalBranch const& conditional_branch, EvaluationNodePtrs&& control_dependencies) :
       m_condition(conditional_branch),
       m_in_true_branch(true),
       m_edge_to_true_branch_added(false),
-      m_edge_to_false_branch_added(false)
+      m_edge_to_false_branch_added(false),
+      m_control_dependencies(std::move(control_dependencies))
 {
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ConditionalBranch.h"
+#include "EvaluationNodePtrs.h"
+#include "NodePtr.h"
 #include <memory>
 #include <vector>
 
@@ -15,9 +17,10 @@ class BranchInfo
                                                                         //  depending whether or not we had a False-branch (false if we did).
   bool m_edge_to_true_branch_added;                                     // Set when the edge from the conditional expression was added that represents 'True'.
   bool m_edge_to_false_branch_added;                                    // Set when the edge from the conditional expression was added that represents 'False'.
+  EvaluationNodePtrs m_control_dependencies;                            // The reads that the conditionals of this and all enclosing selection statements depend on.
 
  public:
-  BranchInfo(ConditionalBranch const& conditional_branch);
+  BranchInfo(ConditionalBranch const& conditional_branch, EvaluationNodePtrs&& control_dependencies);
 
   void begin_branch_false();
   void end_branch();
@@ -27,6 +30,7 @@ class BranchInfo
   bool conditional_edge_of_current_branch_added() const { return m_in_true_branch ? m_edge_to_true_branch_added : m_edge_to_false_branch_added; }
   Condition get_current_condition() const { return m_condition(m_in_true_branch); }
   Condition get_negated_current_condition() const { return m_condition(!m_in_true_branch); }
+  EvaluationNodePtrs const& control_dependencies() const { return m_control_dependencies; }
 
   void print_on(std::ostream& os) const;
   friend std::ostream& operator<<(std::ostream& os, BranchInfo const& branch_info) { branch_info.print_on(os); return os; }
@@ -0,0 +1,55 @@
+#include "sys.h"
+#include "CandidateDeduplicator.h"
+#include "DirectedSubgraph.h"
+#include "FNV1a.h"
+#include "debug.h"
+#include <algorithm>
+
+void CandidateDeduplicator::begin_candidate()
+{
+  m_edges.clear();
+}
+
+void CandidateDeduplicator::add_rf_edges(DirectedSubgraph const& read_from_subgraph)
+{
+  for (DirectedEdge const& directed_edge : read_from_subgraph)
+    m_edges.emplace_back(
+        directed_edge.tail_sequence_number().get_value(),
+        directed_edge.head_sequence_number().get_value(),
+        to_string(directed_edge.condition()));
+}
+
+int CandidateDeduplicator::end_candidate(int candidate, boolean::Expression const& valid)
+{
+  // Make the order of the edges canonical.
+  std::sort(m_edges.begin(), m_edges.end());
+
+  hash_type hash = fnv1a::offset_basis;
+  fnv1a::add(hash, static_cast<int>(m_edges.size()));
+  for (auto const& edge : m_edges)
+  {
+    fnv1a::add(hash, std::get<0>(edge));
+    fnv1a::add(hash, std::get<1>(edge));
+    fnv1a::add(hash, std::get<2>(edge));
+  }
+  fnv1a::add(hash, to_string(valid));
+
+  auto ibp = m_hash_to_graph.emplace(hash, m_graphs.size());
+  if (ibp.second)
+  {
+    m_graphs.emplace_back(1, candidate);
+    return candidate;
+  }
+  candidates_type& candidates{m_graphs[ibp.first->second]};
+  Dout(dc::notice, "Candidate " << candidate << " is the same graph as candidate " << candidates.front() << ".");
+  candidates.push_back(candidate);
+  return candidates.front();
+}
+
+std::string CandidateDeduplicator::to_string(boolean::Expression const& expression)
+{
+  // Reuse the scratch buffer for every expression.
+  m_scratch.str(std::string());
+  m_scratch << expression;
+  return m_scratch.str();
+}
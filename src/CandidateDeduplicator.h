@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FNV1a.h"
+#include "boolean-expression/BooleanExpression.h"
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class DirectedSubgraph;
+
+// Detect rf candidates that result in the same graph.
+//
+// Different MultiLoop index combinations can produce identical
+// witness edge sets. For every candidate we calculate a canonical
+// 128-bit hash (FNV-1a) over its sorted witness edges, including their
+// conditions, and its `valid' expression. Only the first candidate
+// with a given hash needs to be output; all candidates are recorded
+// in the list of the graph that they map to.
+//
+// Usage:
+//
+//   deduplicator.begin_candidate();
+//   for (...)
+//     deduplicator.add_rf_edges(subgraph);
+//   if (deduplicator.end_candidate(candidate, valid) == candidate)
+//     ...output candidate...
+//
+class CandidateDeduplicator
+{
+ public:
+  using hash_type = fnv1a::hash_type;
+  using candidates_type = std::vector<int>;     // The ids of all candidates that map to the same graph; the first one is the one that was output.
+
+ private:
+  std::vector<std::tuple<int, int, std::string>> m_edges;       // The witness edges of the current candidate (tail, head, condition).
+  std::ostringstream m_scratch;                                 // Used to print conditions.
+  std::map<hash_type, size_t> m_hash_to_graph;                  // Index into m_graphs as function of the hash of a graph.
+  std::vector<candidates_type> m_graphs;                        // All distinct graphs, in the order that they were found.
+
+ public:
+  // Start collecting the witness edges of a new candidate.
+  void begin_candidate();
+
+  // Add all rf edges of a read-from subgraph to the current candidate.
+  void add_rf_edges(DirectedSubgraph const& read_from_subgraph);
+
+  // Finish the current candidate. Returns the first candidate with the same graph; that is `candidate' itself if this is a new graph.
+  int end_candidate(int candidate, boolean::Expression const& valid);
+
+  // Accessor.
+  std::vector<candidates_type> const& graphs() const { return m_graphs; }
+
+ private:
+  std::string to_string(boolean::Expression const& expression);
+};
@@ -1,7 +1,16 @@
 #include "sys.h"
 #include "Conditional.h"
+#include "Context.h"
+#include "BooleanVariables.h"
 #include <ostream>
 
+Conditional::Conditional() :
+    m_id(Context::instance().next_conditional_id()),
+    m_boolexpr_variable(BooleanVariables::get(BooleanVariables::conditional, m_id))
+{
+  Dout(dc::notice, "Created a new Conditional with m_boolexpr_variable " << m_boolexpr_variable);
+}
+
 std::string Conditional::id_name() const
 {
   return std::string(1, 'A' + m_id);
@@ -12,6 +21,3 @@ std::ostream& operator<<(std::ostream& os, Conditional const& conditional)
   os << '[' << conditional.m_id << "] " << conditional.m_boolexpr_variable;
   return os;
 }
-
-//static
-Conditional::id_type Conditional::s_next_conditional_id;
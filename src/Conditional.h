@@ -11,13 +11,9 @@ struct Conditional
 
   id_type m_id;
   boolean::Variable m_boolexpr_variable;
-  static id_type s_next_conditional_id;               // The id to use for the next Conditional.
 
   // Construct a new id / boolean variable pair.
-  Conditional() :
-      m_id(s_next_conditional_id++),
-      m_boolexpr_variable(boolean::Context::instance().create_variable(id_name()))
-    { Dout(dc::notice, "Created a new Conditional with m_boolexpr_variable " << m_boolexpr_variable); }
+  Conditional();
 
   id_type id() const { return m_id; }
   std::string id_name() const;
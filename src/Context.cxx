@@ -1,7 +1,9 @@
 #include "sys.h"
 #include "Context.h"
 #include "Graph.h"
+#include "Evaluation.inl"      // Evaluation::for_each_dependency.
 #include "debug_ostream_operators.h"
+#include <algorithm>
 
 #ifdef CWDEBUG
 // To make DoutTag work.
@@ -66,6 +68,7 @@ void Context::read(ast::tag variable, Evaluation& evaluation)
 {
   DoutTag(dc::nodes, "[NA read from", variable);
   auto new_node = m_graph->new_node<NAReadNode>(m_current_thread, variable);
+  add_dependency_edges(new_node);
   // Should be added as side effect when variable is volatile.
   evaluation.add_value_computation(new_node);
 }
@@ -74,6 +77,7 @@ void Context::write(ast::tag variable, Evaluation&& evaluation, bool side_effect
 {
   DoutTag(dc::nodes, "[NA write to", variable);
   auto write_node_ptr = m_graph->new_node<NAWriteNode>(m_current_thread, variable, std::move(evaluation));
+  add_dependency_edges(write_node_ptr, write_node_ptr.get<WriteNode>()->get_evaluation());
 #ifdef TRACK_EVALUATION
   evaluation.refresh(); // Allow re-use of moved object.
 #endif
@@ -115,6 +119,7 @@ void Context::read(ast::tag variable, std::memory_order mo, Evaluation& evaluati
 {
   DoutTag(dc::nodes, "[" << mo << " read from", variable);
   auto new_node = m_graph->new_node<AtomicReadNode>(m_current_thread, variable, mo);
+  add_dependency_edges(new_node);
   // Should be added as side effect when variable is volatile.
   evaluation.add_value_computation(new_node);
 }
@@ -123,6 +128,7 @@ NodePtr Context::write(ast::tag variable, std::memory_order mo, Evaluation&& eva
 {
   DoutTag(dc::nodes, "[" << mo << " write to", variable);
   auto write_node = m_graph->new_node<AtomicWriteNode>(m_current_thread, variable, mo, std::move(evaluation));
+  add_dependency_edges(write_node, write_node.get<WriteNode>()->get_evaluation());
 #ifdef TRACK_EVALUATION
   evaluation.refresh(); // Allow re-use of moved object.
 #endif
@@ -135,6 +141,7 @@ NodePtr Context::RMW(ast::tag variable, std::memory_order mo, Evaluation&& evalu
 {
   DoutTag(dc::nodes, "[" << mo << " RMW of", variable);
   auto rmw_node = m_graph->new_node<RMWNode>(m_current_thread, variable, mo, std::move(evaluation));
+  add_dependency_edges(rmw_node, rmw_node.get<WriteNode>()->get_evaluation());
 #ifdef TRACK_EVALUATION
   evaluation.refresh(); // Allow re-use of moved object.
 #endif
@@ -148,6 +155,7 @@ NodePtr Context::compare_exchange_weak(
 {
   DoutTag(dc::nodes, "[" << success << '/' << fail << " compare_exchange_weak of", variable);
   auto cew_node = m_graph->new_node<CEWNode>(m_current_thread, variable, expected, desired, success, fail, std::move(evaluation));
+  add_dependency_edges(cew_node, cew_node.get<WriteNode>()->get_evaluation());
 #ifdef TRACK_EVALUATION
   evaluation.refresh(); // Allow re-use of moved object.
 #endif
@@ -160,6 +168,7 @@ Evaluation Context::lockdecl(ast::tag mutex)
 {
   DoutTag(dc::notice, "[declaration of", mutex);
   auto mutex_decl_node = m_graph->new_node<MutexDeclNode>(m_current_thread, mutex);
+  add_dependency_edges(mutex_decl_node);
   Evaluation result = mutex;
   result.add_side_effect(mutex_decl_node);
   return result;
@@ -169,9 +178,11 @@ Evaluation Context::lock(ast::tag mutex)
 {
   DoutTag(dc::nodes, "[lock of", mutex);
   auto mutex_node1 = m_graph->new_node<MutexReadNode>(m_current_thread, mutex);
+  add_dependency_edges(mutex_node1);
   Evaluation result = mutex;
   result.add_value_computation(mutex_node1);
   auto mutex_node2 = m_graph->new_node<MutexLockNode>(m_current_thread, mutex);
+  add_dependency_edges(mutex_node2);
   // Adding this as a side effect for now...
   result.add_side_effect(mutex_node2);
   m_graph->new_edge(edge_sb, mutex_node1, mutex_node2);
@@ -182,9 +193,11 @@ Evaluation Context::unlock(ast::tag mutex)
 {
   DoutTag(dc::nodes, "[unlock of", mutex);
   auto mutex_node1 = m_graph->new_node<MutexReadNode>(m_current_thread, mutex);
+  add_dependency_edges(mutex_node1);
   Evaluation result = mutex;
   result.add_value_computation(mutex_node1);
   auto mutex_node2 = m_graph->new_node<MutexUnlockNode>(m_current_thread, mutex);
+  add_dependency_edges(mutex_node2);
   // Adding this as a side effect for now...
   result.add_side_effect(mutex_node2);
   m_graph->new_edge(edge_sb, mutex_node1, mutex_node2);
@@ -243,14 +256,40 @@ void Context::add_edges(
       after_evaluation.get_nodes(NodeRequestedType::tails COMMA_DEBUG_ONLY(edge_type)));
 }
 
-//static
-std::vector<std::unique_ptr<Evaluation>> Context::s_condition_evaluations;
-
-namespace {
+EvaluationNodePtrs Context::data_dependencies(Evaluation const& evaluation) const
+{
+  EvaluationNodePtrs result;
+  auto add = [&result](NodePtr const& read_node)
+  {
+    if (std::find(result.begin(), result.end(), read_node.get_iterator()) == result.end())
+      result.push_back(read_node);
+  };
+  evaluation.for_each_dependency(add,
+      [this, &add](ast::tag variable)
+      {
+        auto register_dependencies = m_register_dependencies.find(variable.id);
+        if (register_dependencies != m_register_dependencies.end())
+          for (NodePtr const& read_node : register_dependencies->second)
+            add(read_node);
+      });
+  return result;
+}
 
-SingletonInstance<Context> dummy __attribute__ ((__unused__));
+void Context::add_dependency_edges(NodePtr const& new_node, Evaluation const* value)
+{
+  // Dependencies only exist within one thread.
+  if (value)
+    for (NodePtr const& read_node : data_dependencies(*value))
+      if (read_node->thread() == new_node->thread())
+        m_graph->new_edge(edge_dd, read_node, new_node);
+  if (EvaluationNodePtrs const* control_dependencies = m_current_thread->control_dependencies())
+    for (NodePtr const& read_node : *control_dependencies)
+      if (read_node->thread() == new_node->thread())
+        m_graph->new_edge(edge_cd, read_node, new_node);
+}
 
-} // namespace
+//static
+thread_local Context* Context::s_instance;
 
 #ifdef CWDEBUG
 NAMESPACE_DEBUG_CHANNELS_START
@@ -10,16 +10,21 @@
 #include "Node.h"
 #include "Location.h"
 #include "ReleaseSequences.h"
-#include "utils/Singleton.h"
 #include <string>
+#include <map>
 #include <set>
 
 class Graph;
-using iterator_type = std::string::const_iterator;
+using iterator_type = char const*;
 
-class Context : public Singleton<Context>
+// The state of the opsem generation of one test.
+//
+// A Context is owned by an AnalysisSession; Context::instance() returns
+// the Context of the current session of the calling thread.
+//
+class Context
 {
-  friend_Instance;
+  friend class AnalysisSession;
 
   using threads_final_full_expression_type = std::map<int, std::vector<std::unique_ptr<Evaluation>>>;
 
@@ -37,17 +42,30 @@ class Context : public Singleton<Context>
   std::stack<bool> m_threads;                                           // Whether or not current scope is a thread.
   conditionals_type m_conditionals;                                     // Branch conditionals.
   locations_type m_locations;                                           // List of all memory locations used.
-  static std::vector<std::unique_ptr<Evaluation>> s_condition_evaluations;
+  std::vector<std::unique_ptr<Evaluation>> m_condition_evaluations;     // Keeps the Evaluation objects of m_conditionals alive.
+  std::map<int, EvaluationNodePtrs> m_register_dependencies;            // The reads that the current value of each register depends on, by tag id.
+  Conditional::id_type m_next_conditional_id;                           // The id to use for the next Conditional.
+  ReleaseSequence::id_type m_next_release_sequence_id;                  // The id to use for the next ReleaseSequence.
+
+  static thread_local Context* s_instance;                              // The Context of the current AnalysisSession of this thread.
 
  private:
-  Context() : m_position_handler(nullptr), m_graph(nullptr), m_next_thread_id{1}, m_current_thread{Thread::create_main_thread()} { }
+  Context() : m_position_handler(nullptr), m_graph(nullptr), m_next_thread_id{1}, m_current_thread{Thread::create_main_thread()},
+      m_next_conditional_id{0}, m_next_release_sequence_id{0} { }
   ~Context() { }
   Context(Context const&) = delete;
 
  public:
+  // Return the Context of the current AnalysisSession.
+  static Context& instance() { ASSERT(s_instance); return *s_instance; }
+
   // Only call this once.
   void initialize(position_handler<iterator_type>& ph, Graph& g) { ASSERT(!m_position_handler); m_position_handler = &ph; m_graph = &g; }
 
+  // Return a new, unique id.
+  Conditional::id_type next_conditional_id() { return m_next_conditional_id++; }
+  ReleaseSequence::id_type next_release_sequence_id() { return m_next_release_sequence_id++; }
+
   // Entering and leaving scopes.
   void scope_start(bool is_thread);
   void scope_end();
@@ -75,6 +93,12 @@ class Context : public Singleton<Context>
   Graph& graph() const { return *m_graph; }
   locations_type const& locations() const { return m_locations; }
 
+  // Data dependencies.
+  // Return the reads that the value of evaluation depends on, including those of the registers that it uses.
+  EvaluationNodePtrs data_dependencies(Evaluation const& evaluation) const;
+  // Assign the value of evaluation to register reg.
+  void assign_register(ast::tag reg, Evaluation const& evaluation) { m_register_dependencies[reg.id] = data_dependencies(evaluation); }
+
   // Mutex declaration and (un)locking.
   Evaluation lockdecl(ast::tag mutex);
   Evaluation lock(ast::tag mutex);
@@ -131,9 +155,14 @@ class Context : public Singleton<Context>
   {
     ConditionalBranch result{add_condition(condition)};
     // Keep a std::unique_ptr around to stop this Evaluation from being deleted.
-    s_condition_evaluations.emplace_back(std::move(condition));
+    m_condition_evaluations.emplace_back(std::move(condition));
     return result;
   }
+
+ private:
+  // Add the Data-Dependency edges to new_node from the reads that value depends on (if value is non-null),
+  // and the Control-Dependency edges from the reads that the conditionals of the current branch depend on.
+  void add_dependency_edges(NodePtr const& new_node, Evaluation const* value = nullptr);
 };
 
 // Statements that are not expressions, but contain expressions, are
@@ -4,9 +4,9 @@
 #include "Graph.h"
 #include <iostream>
 
-void DirectedEdge::add_to(Graph&, Action* tail_node) const
+void DirectedEdge::add_to(Graph&) const
 {
-  tail_node->add_edge_to(m_edge_type, m_head_node, m_condition.copy());
+  m_tail_node->add_edge_to(m_edge_type, m_head_node, m_condition.copy());
 }
 
 std::ostream& operator<<(std::ostream& os, DirectedEdge const& directed_edge)
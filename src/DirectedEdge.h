@@ -31,7 +31,10 @@ class DirectedEdge
           head_node->read_memory_order() == std::memory_order_acq_rel ||
           head_node->read_memory_order() == std::memory_order_seq_cst))) { }
 
-  void add_to(Graph& graph, Action* tail_node) const;
+  void add_to(Graph& graph) const;
+  Action const* tail_node() const { return m_tail_node; }
+  Action const* head_node() const { return m_head_node; }
+  EdgeType edge_type() const { return m_edge_type; }
   boolean::Expression const& condition() const { return m_condition; }
   bool is_rf_not_release_acquire() const { return m_rf_not_release_acquire; }
   SequenceNumber tail_sequence_number() const { return m_tail_node->sequence_number(); }
@@ -1,36 +1,63 @@
 #pragma once
 
 #include "DirectedEdge.h"
-#include "EdgeType.h"
-#include <vector>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
 
-class Action;
-class Graph;
+// An iterator over a range of edge indices, dereferencing to the DirectedEdge that the index refers to.
+class DirectedEdgeIterator
+{
+ public:
+  using index_type = uint16_t;          // The type of the index of an edge in its DirectedSubgraph.
+
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = DirectedEdge;
+  using difference_type = std::ptrdiff_t;
+  using pointer = DirectedEdge const*;
+  using reference = DirectedEdge const&;
 
+ private:
+  DirectedEdge const* m_edges;          // All edges of the subgraph.
+  index_type const* m_index;            // The current index into m_edges.
+
+ public:
+  DirectedEdgeIterator(DirectedEdge const* edges, index_type const* index) : m_edges(edges), m_index(index) { }
+
+  reference operator*() const { return m_edges[*m_index]; }
+  pointer operator->() const { return &m_edges[*m_index]; }
+  DirectedEdgeIterator& operator++() { ++m_index; return *this; }
+  DirectedEdgeIterator operator++(int) { DirectedEdgeIterator tmp{*this}; ++m_index; return tmp; }
+
+  friend bool operator==(DirectedEdgeIterator const& lhs, DirectedEdgeIterator const& rhs) { return lhs.m_index == rhs.m_index; }
+  friend bool operator!=(DirectedEdgeIterator const& lhs, DirectedEdgeIterator const& rhs) { return lhs.m_index != rhs.m_index; }
+};
+
+// The outgoing and incoming edges of a single node of a DirectedSubgraph.
+//
+// This is a light-weight view that refers to the storage of the DirectedSubgraph
+// that returned it; it is only valid as long as that subgraph exists.
+//
 class DirectedEdges
 {
  public:
-  using directed_edges_type = std::vector<DirectedEdge>;
+  using const_iterator = DirectedEdgeIterator;
 
  private:
-  directed_edges_type m_outgoing_edges;
-  directed_edges_type m_incoming_edges;
-  Action* m_action;
+  const_iterator m_begin_outgoing;
+  const_iterator m_end_outgoing;
+  const_iterator m_begin_incoming;
+  const_iterator m_end_incoming;
 
  public:
-  DirectedEdges() { }
-  DirectedEdges(EdgeMaskType outgoing_edge_mask_type, EdgeMaskType incoming_edge_mask_type, Action* action);
-
-  void add_to(Graph& graph) const;
-  Action& action() const { return *m_action; }
+  DirectedEdges(const_iterator begin_outgoing, const_iterator end_outgoing, const_iterator begin_incoming, const_iterator end_incoming) :
+    m_begin_outgoing(begin_outgoing), m_end_outgoing(end_outgoing), m_begin_incoming(begin_incoming), m_end_incoming(end_incoming) { }
 
-  directed_edges_type::iterator begin_outgoing() { return m_outgoing_edges.begin(); }
-  directed_edges_type::const_iterator begin_outgoing() const { return m_outgoing_edges.begin(); }
-  directed_edges_type::const_iterator end_outgoing() const { return m_outgoing_edges.end(); }
+  const_iterator begin_outgoing() const { return m_begin_outgoing; }
+  const_iterator end_outgoing() const { return m_end_outgoing; }
 
-  directed_edges_type::iterator begin_incoming() { return m_incoming_edges.begin(); }
-  directed_edges_type::const_iterator begin_incoming() const { return m_incoming_edges.begin(); }
-  directed_edges_type::const_iterator end_incoming() const { return m_incoming_edges.end(); }
+  const_iterator begin_incoming() const { return m_begin_incoming; }
+  const_iterator end_incoming() const { return m_end_incoming; }
 
   friend std::ostream& operator<<(std::ostream& os, DirectedEdges const& directed_edges);
 };
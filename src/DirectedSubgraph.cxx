@@ -1,38 +1,109 @@
 #include "sys.h"
 #include "DirectedSubgraph.h"
 #include "Graph.h"
-#include "utils/MultiLoop.h"
+#include "Edge.h"
+#include <algorithm>
+#include <limits>
 #include <utility>
 #include <iostream>
 
 DirectedSubgraph::DirectedSubgraph(Graph const& graph, EdgeMaskType outgoing_type, EdgeMaskType incoming_type, boolean::Expression&& condition) :
-    m_condition(std::move(condition))
+    m_offsets(graph.size() + 1), m_condition(std::move(condition))
 {
-  ASSERT(m_nodes.empty());
-  m_nodes.resize(graph.size());
-  size_t count = 0;
+  // An edge, together with the position of its end point among the end points of its head node.
+  struct CollectedEdge
+  {
+    DirectedEdge m_directed_edge;
+    size_t m_head_position;
+  };
+
+  // Collect all edges of either type, each from its tail.
+  EdgeMaskType const either_type{EdgeMaskTypePod{outgoing_type.mask | incoming_type.mask}};
+  std::vector<CollectedEdge> collected_edges;
   for (auto&& action_ptr : graph)
   {
-    ASSERT(action_ptr->sequence_number().get_value() < m_nodes.size());
-    m_nodes[action_ptr->sequence_number()] = DirectedEdges(outgoing_type, incoming_type, action_ptr.get());
-    ++count;
+    ASSERT(action_ptr->sequence_number().get_value() < graph.size());
+    for (auto&& end_point : action_ptr->get_end_points())
+      if ((end_point.edge_type() & either_type) && end_point.type() == tail)
+      {
+        size_t head_position = 0;
+        for (auto&& head_end_point : end_point.other_node()->get_end_points())
+        {
+          if (head_end_point.edge() == end_point.edge() && head_end_point.type() == head)
+            break;
+          ++head_position;
+        }
+        collected_edges.push_back({{action_ptr.get(), end_point.other_node(), end_point.edge_type(), end_point.edge()->condition()}, head_position});
+      }
+  }
+  // Keep the order of the end points of every node.
+  std::stable_sort(collected_edges.begin(), collected_edges.end(),
+      [](CollectedEdge const& e1, CollectedEdge const& e2){ return e1.m_directed_edge.tail_sequence_number() < e2.m_directed_edge.tail_sequence_number(); });
+  ASSERT(collected_edges.size() <= std::numeric_limits<index_type>::max());
+  std::vector<size_t> head_positions;
+  m_edges.reserve(collected_edges.size());
+  head_positions.reserve(collected_edges.size());
+  for (CollectedEdge& collected_edge : collected_edges)
+  {
+    m_edges.push_back(std::move(collected_edge.m_directed_edge));
+    head_positions.push_back(collected_edge.m_head_position);
+  }
+
+  // Count the edges per node, storing the count of node n at n + 1.
+  for (index_type index = 0; index < m_edges.size(); ++index)
+  {
+    DirectedEdge const& directed_edge{m_edges[index]};
+    if ((directed_edge.edge_type() & outgoing_type))
+    {
+      m_outgoing.push_back(index);              // Already sorted by tail.
+      ++m_offsets[directed_edge.tail_sequence_number().get_value() + 1].m_outgoing;
+    }
+    if ((directed_edge.edge_type() & incoming_type))
+    {
+      m_incoming.push_back(index);
+      ++m_offsets[directed_edge.head_sequence_number().get_value() + 1].m_incoming;
+    }
+  }
+  // Sort the incoming edges by head, and those of the same head in the order of the end points of that head node
+  // (the order in which the edges were added to the graph), as ReadFromGraph::dfs follows them in this order.
+  std::sort(m_incoming.begin(), m_incoming.end(),
+      [this, &head_positions](index_type i1, index_type i2){
+        SequenceNumber const head1 = m_edges[i1].head_sequence_number();
+        SequenceNumber const head2 = m_edges[i2].head_sequence_number();
+        return head1 < head2 || (head1 == head2 && head_positions[i1] < head_positions[i2]);
+      });
+
+  // Turn the counts into offsets.
+  for (size_t n = 1; n < m_offsets.size(); ++n)
+  {
+    m_offsets[n].m_outgoing += m_offsets[n - 1].m_outgoing;
+    m_offsets[n].m_incoming += m_offsets[n - 1].m_incoming;
   }
-  ASSERT(count == m_nodes.size());
 }
 
 void DirectedSubgraph::add_to(Graph& graph) const
 {
-  for (DirectedEdges const& directed_edge_tails : m_nodes)
-    directed_edge_tails.add_to(graph);
+  // Don't add the "incoming" edges because they are just duplicates.
+  for (DirectedEdge const& directed_edge : *this)
+    directed_edge.add_to(graph);
+}
+
+void DirectedSubgraph::write_dot_edges(std::ostream& out) const
+{
+  for (DirectedEdge const& directed_edge : *this)
+    Graph::write_dot_edge(out, directed_edge.tail_node(), directed_edge.head_node(), directed_edge.edge_type(), directed_edge.condition());
 }
 
 std::ostream& operator<<(std::ostream& os, DirectedSubgraph const& directed_subgraph)
 {
   char const* sep = "<subgraph>";
 
-  for (auto&& directed_tails : directed_subgraph.m_nodes)
+  for (size_t n = 0; n < directed_subgraph.number_of_nodes(); ++n)
   {
-    os << sep << directed_tails;
+    DirectedSubgraph::NodeOffsets const* offsets = &directed_subgraph.m_offsets[n];
+    if (offsets[0].m_outgoing == offsets[1].m_outgoing && offsets[0].m_incoming == offsets[1].m_incoming)
+      continue;
+    os << sep << n << ':' << directed_subgraph.edges(SequenceNumber{n});
     sep = ", ";
   }
   return os << "</subgraph>";
@@ -4,17 +4,40 @@
 #include <vector>
 
 class Graph;
-class DirectedEdges;
-class MultiLoop;
-class ReadFromLocationSubgraphs;
 
+// A subgraph of a Graph: the edges of (some of) the types in a mask.
+//
+// Only the edges themselves are stored, sorted by the SequenceNumber of
+// their tail, together with two arrays of indices into them: one for the
+// outgoing and one for the incoming edges, sorted by tail and head
+// respectively. The edges of one node are kept in the order of its end
+// points (see Action::get_end_points), so that a traversal follows them
+// in the order in which they were added to the graph. A per-node offset
+// table into those index arrays makes looking up the outgoing and the
+// incoming edges of a node equally fast.
+//
+// Hence the memory used is proportional to the number of edges: read-from
+// subgraphs only have a few edges, while there can be many subgraphs per
+// location and many nodes per graph.
+//
 class DirectedSubgraph
 {
  public:
-  using nodes_type = utils::Vector<DirectedEdges, SequenceNumber>;
+  using edges_type = std::vector<DirectedEdge>;
+  using index_type = DirectedEdgeIterator::index_type;
+  using const_iterator = edges_type::const_iterator;
 
- protected:
-  nodes_type m_nodes;
+ private:
+  struct NodeOffsets
+  {
+    index_type m_outgoing;                      // Index into m_outgoing of the first outgoing edge of this node.
+    index_type m_incoming;                      // Index into m_incoming of the first incoming edge of this node.
+  };
+
+  edges_type m_edges;                           // All edges of the subgraph, sorted by tail.
+  std::vector<index_type> m_outgoing;           // Indices into m_edges of the edges of the outgoing type, sorted by tail.
+  std::vector<index_type> m_incoming;           // Indices into m_edges of the edges of the incoming type, sorted by head.
+  std::vector<NodeOffsets> m_offsets;           // The offsets of each node (plus one past the last node), using the SequenceNumber as index.
   boolean::Expression m_condition;              // The condition under which this subgraph is valid.
 
  public:
@@ -22,10 +45,27 @@ class DirectedSubgraph
 
   // Add this subgraph to graph.
   void add_to(Graph& graph) const;
+  // Write the (outgoing) edges of this subgraph in dot format.
+  void write_dot_edges(std::ostream& out) const;
   // Return condition under which this subgraph is valid.
   boolean::Expression const& valid() const { return m_condition; }
+  // Return the number of nodes of the graph that this is a subgraph of.
+  size_t number_of_nodes() const { return m_offsets.size() - 1; }
+
   // Return the stored edges (as filtered by incoming_type/outgoing_type) of node n for this subgraph.
-  DirectedEdges const& edges(SequenceNumber n) const { return m_nodes[n]; }
+  DirectedEdges edges(SequenceNumber n) const
+  {
+    NodeOffsets const* offsets = &m_offsets[n.get_value()];
+    DirectedEdge const* edges = m_edges.data();
+    return {
+      { edges, m_outgoing.data() + offsets[0].m_outgoing }, { edges, m_outgoing.data() + offsets[1].m_outgoing },
+      { edges, m_incoming.data() + offsets[0].m_incoming }, { edges, m_incoming.data() + offsets[1].m_incoming }
+    };
+  }
+
+  // Iterate over the edges of the outgoing type of all nodes, in order of the SequenceNumber of their tail.
+  DirectedEdgeIterator begin() const { return { m_edges.data(), m_outgoing.data() }; }
+  DirectedEdgeIterator end() const { return { m_edges.data(), m_outgoing.data() + m_outgoing.size() }; }
 
   friend std::ostream& operator<<(std::ostream& os, DirectedSubgraph const& directed_subgraph);
 };
@@ -0,0 +1,68 @@
+#include "sys.h"
+#include "DotRenderer.h"
+#include "debug.h"
+
+DotRenderer::DotRenderer(unsigned int max_processes, bool dot_only) :
+  m_max_processes(max_processes > 0 ? max_processes : 1), m_max_pending(4 * m_max_processes), m_dot_only(dot_only)
+{
+}
+
+DotRenderer::~DotRenderer()
+{
+  wait_all();
+}
+
+void DotRenderer::render(std::string const& dot_filename, std::string const& png_filename, bool neato)
+{
+  if (m_dot_only)
+    return;
+  std::string command = "dot ";
+  if (neato)
+    command += "-Kneato ";
+  command += "-Tpng -o " + png_filename + " " + dot_filename;
+  m_pending.push_back({std::move(command)});
+  pump();
+  // Only block when the queue is full.
+  while (m_pending.size() > m_max_pending)
+  {
+    wait_oldest();
+    pump();
+  }
+}
+
+void DotRenderer::wait_all()
+{
+  pump();
+  while (!m_running.empty())
+  {
+    wait_oldest();
+    pump();
+  }
+}
+
+void DotRenderer::pump()
+{
+  // Remove all renderers that already exited.
+  for (auto process = m_running.begin(); process != m_running.end();)
+  {
+    if ((*process)->rdbuf()->exited())
+      process = m_running.erase(process);
+    else
+      ++process;
+  }
+  // Start as many pending jobs as allowed.
+  while (!m_pending.empty() && m_running.size() < m_max_processes)
+  {
+    Dout(dc::notice, "Starting renderer: " << m_pending.front().m_command);
+    m_running.emplace_back(new redi::ipstream(m_pending.front().m_command));
+    m_pending.pop_front();
+  }
+}
+
+void DotRenderer::wait_oldest()
+{
+  if (m_running.empty())
+    return;
+  m_running.front()->close();
+  m_running.pop_front();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "pstreams/pstream.h"
+#include <deque>
+#include <memory>
+#include <string>
+
+// Convert .dot files to .png files in the background.
+//
+// Every call to render() queues a job; up to m_max_processes jobs are
+// running at the same time as child processes of this process (started
+// through pstreams). Enumeration of the candidates only blocks when the
+// queue of pending jobs is full, in which case we wait for the oldest
+// running renderer to finish.
+//
+// When m_dot_only is set, render() does nothing: only the .dot files
+// are written and no conversion to PNG takes place at all.
+//
+class DotRenderer
+{
+ private:
+  struct Job
+  {
+    std::string m_command;              // The shell command that renders the .png file.
+  };
+
+  std::deque<Job> m_pending;                                    // Jobs that are not started yet.
+  std::deque<std::unique_ptr<redi::ipstream>> m_running;        // The currently running renderer processes, oldest first.
+  unsigned int const m_max_processes;                           // The maximum number of concurrently running renderer processes.
+  size_t const m_max_pending;                                   // The maximum number of queued jobs before render() blocks.
+  bool const m_dot_only;                                        // Set if no .png files should be generated.
+
+ public:
+  DotRenderer(unsigned int max_processes, bool dot_only);
+  ~DotRenderer();
+
+  // Queue the conversion of dot_filename into png_filename. Use the neato layout engine if `neato' is set.
+  void render(std::string const& dot_filename, std::string const& png_filename, bool neato);
+
+  // Block until all queued jobs are finished.
+  void wait_all();
+
+  // Accessor.
+  bool dot_only() const { return m_dot_only; }
+
+ private:
+  // Remove finished processes and start pending jobs, without blocking.
+  void pump();
+  // Block until the oldest running process finished.
+  void wait_oldest();
+};
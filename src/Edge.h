@@ -3,6 +3,7 @@
 #include "debug.h"
 #include "Condition.h"
 #include "EdgeType.h"
+#include "Stats.h"
 #include "utils/is_power_of_two.h"
 #include <iosfwd>
 
@@ -71,8 +72,7 @@ class Edge
   EdgeType m_edge_type;
   boolean::Expression m_condition;
   Action* m_tail_node;                          // The Node from where the edge starts:  tail_node ---> head_node.
-  int m_visited;                                // A helper variable used by post opsem.
-  boolean::Expression m_visited_condition;      // The condition under which this edge is visited.
+  int m_opsem_index;                            // A dense index of all sb and asw edges, set by Action::initialize_post_opsem (see VisitedEdges).
 
 #ifdef CWDEBUG
   int m_id;             // For debugging purposes.
@@ -86,9 +86,10 @@ class Edge
       m_edge_type(edge_type),
       m_condition(std::move(condition)),
       m_tail_node(tail_node),
-      m_visited(0)
+      m_opsem_index(-1)
       COMMA_DEBUG_ONLY(m_id(s_id++))
       {
+        stats::increment(stats::edge_allocations);
         Dout(dc::sb_edge(edge_type == edge_sb)|
              dc::asw_edge(edge_type == edge_asw),
              "Creating " << edge_type << " Edge " << m_id << '.');
@@ -99,39 +100,15 @@ class Edge
   Action* tail_node() const { return m_tail_node; }
   char const* name() const { return edge_name(m_edge_type); }
   bool is_opsem() const { return EdgeMaskType{m_edge_type}.is_opsem(); }
+  bool is_sbw() const { return EdgeMaskType{m_edge_type}.is_sbw(); }
   bool is_directed() const { return EdgeMaskType{m_edge_type}.is_directed(); }
 
   inline bool is_conditional() const;
   inline boolean::Expression exists() const;
 
   // Post opsem stuff.
-  void visited(int visited_generation, boolean::Expression const& path_condition)
-  {
-    // Multiply the path_condition so far with the condition of this edge.
-    boolean::Expression path_condition_including_edge{path_condition * m_condition.as_product()};
-    if (m_visited != visited_generation)
-    {
-      Dout(dc::visited, "Setting m_visited_condition to " << path_condition_including_edge << " because new visited_generation " <<
-          visited_generation << " is unequal old value " << m_visited);
-      m_visited_condition = std::move(path_condition_including_edge);
-      m_visited = visited_generation;
-    }
-    else
-    {
-      Dout(dc::visited|continued_cf, "Updating m_visited_condition from " << m_visited_condition << ' ');
-      m_visited_condition += path_condition_including_edge;
-      Dout(dc::finish, "to " << m_visited_condition);
-    }
-  }
-  bool is_visited(int visited_generation) const { return m_visited == visited_generation; }
-  boolean::Expression const& visited_condition(int visited_generation) const
-  {
-    // If a recursive algorithm incremented visited_generation and wrote where we are still
-    // checking if edges have been visited, then it might have overwritten our value and
-    // we'd return false where we should have returned true.
-    ASSERT(m_visited <= visited_generation);
-    return m_visited == visited_generation ? m_visited_condition : boolean::Expression::zero();
-  }
+  void set_opsem_index(int opsem_index) { m_opsem_index = opsem_index; }
+  int opsem_index() const { return m_opsem_index; }
 
   friend std::ostream& operator<<(std::ostream& os, Edge const& edge);
   friend bool operator==(Edge const& edge1, Edge const& edge2) { return edge1.m_edge_type == edge2.m_edge_type; }
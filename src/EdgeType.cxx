@@ -55,8 +55,8 @@ static char const* edge_color_array[edge_bits] =
   {
     "black",            // sb
     "purple",           // asw
-   "dd",
-   "cd",
+    "darkgreen",        // dd
+    "goldenrod",        // cd
     "red",              // rf
    "tot",
     "blue",             // mo
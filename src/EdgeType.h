@@ -45,6 +45,8 @@ EdgeMaskTypePod constexpr edge_mask_dd    = { to_mask(edge_dd) };       // Data-
 EdgeMaskTypePod constexpr edge_mask_cd    = { to_mask(edge_cd) };       // Control-Dependency.
 EdgeMaskTypePod constexpr edge_mask_sbw   = { edge_mask_sb.mask | edge_mask_asw.mask };
 EdgeMaskTypePod constexpr edge_mask_opsem = { edge_mask_sb.mask | edge_mask_asw.mask | edge_mask_dd.mask | edge_mask_cd.mask };
+// The tail of a dd or cd edge is always sequenced before its head; therefore walking
+// the opsem graph (topological ordering, path conditions) only follows sb and asw edges.
 // Next we have several relations that are existentially quantified: for each choice of control-flow paths;
 // the program enumerates all possible alternatives of the following:
 EdgeMaskTypePod constexpr edge_mask_rf    = { to_mask(edge_rf) };       // The Reads-From relation, from writes to all the reads that read from them.
@@ -75,6 +77,7 @@ struct EdgeMaskType : public EdgeMaskTypePod
   friend bool operator&(EdgeType edge_type, EdgeMaskTypePod edge_mask_type) { return to_mask(edge_type) & edge_mask_type.mask; }
   friend bool operator&(EdgeMaskTypePod edge_mask_type, EdgeType edge_type) { return to_mask(edge_type) & edge_mask_type.mask; }
   bool is_opsem() const { return mask & edge_mask_opsem.mask; }
+  bool is_sbw() const { return mask & edge_mask_sbw.mask; }
   bool is_directed() const { return !(mask & edge_mask_undirected.mask); }
   bool operator==(EdgeMaskTypePod edge_mask_type) const { return mask == edge_mask_type.mask; }
 };
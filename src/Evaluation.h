@@ -151,6 +151,10 @@ class Evaluation
   void print_on(std::ostream& os) const;
   void for_each_node(NodeRequestedType const& requested_type, std::function<void(NodePtr const&)> const& action COMMA_DEBUG_ONLY(EdgeType edge_type)) const;
   EvaluationNodePtrs get_nodes(NodeRequestedType const& requested_type COMMA_DEBUG_ONLY(EdgeType edge_type)) const;
+  // Call read_action for every read node whose value is used to compute the value of this evaluation, and
+  // register_action for every variable without nodes (a register) whose value is used. See Evaluation.inl.
+  template<class READ_ACTION, class REGISTER_ACTION>
+  void for_each_dependency(READ_ACTION const& read_action, REGISTER_ACTION const& register_action) const;
 
   // Accessors used to print RMW node labels. See RMWNode::print_code.
   State state() const { return m_state; }
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Node.h"       // WriteNode.
+
+template<class READ_ACTION, class REGISTER_ACTION>
+void Evaluation::for_each_dependency(READ_ACTION const& read_action, REGISTER_ACTION const& register_action) const
+{
+  switch (m_state)
+  {
+    case unused:
+      ASSERT(m_state != unused);
+      break;
+    case uninitialized:
+      break;
+    case literal:
+      break;
+    case variable:
+    {
+      if (m_value_computations.empty() && m_side_effects.empty())
+      {
+        register_action(m_simple.m_variable);
+        break;
+      }
+      // The value of an RMW is the value that it read; its own evaluation is only the value that it writes.
+      for (auto&& node : m_value_computations)
+        if (node->is_read())
+          read_action(node);
+      // The value of an assignment is the value that was written.
+      for (auto&& node : m_side_effects)
+        if (WriteNode const* write_node = node.get<WriteNode>())
+          write_node->get_evaluation()->for_each_dependency(read_action, register_action);
+      break;
+    }
+    case pre:
+    case post:
+    case unary:
+      m_lhs->for_each_dependency(read_action, register_action);
+      break;
+    case binary:
+      m_lhs->for_each_dependency(read_action, register_action);
+      m_rhs->for_each_dependency(read_action, register_action);
+      break;
+    case condition:
+      m_condition->for_each_dependency(read_action, register_action);
+      m_lhs->for_each_dependency(read_action, register_action);
+      m_rhs->for_each_dependency(read_action, register_action);
+      break;
+    case comma:
+      // The value of a comma expression is the value of its right-hand side.
+      m_rhs->for_each_dependency(read_action, register_action);
+      break;
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// 128-bit FNV-1a hashing.
+namespace fnv1a {
+
+using hash_type = unsigned __int128;
+
+// The 128-bit FNV parameters.
+hash_type constexpr offset_basis = (hash_type{0x6c62272e07bb0142ULL} << 64) | 0x62b821756295c58dULL;
+hash_type constexpr prime = (hash_type{0x0000000001000000ULL} << 64) | 0x000000000000013bULL;
+
+inline void add(hash_type& hash, char const* data, size_t len)
+{
+  for (size_t i = 0; i < len; ++i)
+  {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= prime;
+  }
+}
+
+inline void add(hash_type& hash, int value)
+{
+  add(hash, reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+inline void add(hash_type& hash, std::string const& str)
+{
+  // Include the length, so that concatenations of different strings can't collide.
+  add(hash, static_cast<int>(str.size()));
+  add(hash, str.data(), str.size());
+}
+
+// Return hash as 32 hexadecimal digits.
+inline std::string to_string(hash_type hash)
+{
+  static char const digits[] = "0123456789abcdef";
+  std::string result(32, '0');
+  for (int i = 31; i >= 0; --i, hash >>= 4)
+    result[i] = digits[static_cast<int>(hash & 0xf)];
+  return result;
+}
+
+} // namespace fnv1a
@@ -5,6 +5,6 @@ struct FollowOpsemTails
 {
   bool operator()(EndPoint const& end_point) const
   {
-    return end_point.edge()->is_opsem() && end_point.type() == tail;
+    return end_point.edge()->is_sbw() && end_point.type() == tail;
   }
 };
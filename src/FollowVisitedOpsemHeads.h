@@ -1,7 +1,11 @@
 #pragma once
 #include "Edge.h"
 #include "Action.h"
-#include <set>
+#include "VisitedEdges.h"
+#include "FilterLocation.h"
+#include "Action.inl"
+#include <array>
+#include <cstdint>
 
 // This class follows sb and asw edges 'upstream' (bottom to top) while keeping track
 // of the condition under which the Read node that we started from will see the
@@ -77,27 +81,89 @@
 
 struct FollowVisitedOpsemHeads
 {
-  struct SequenceNumberCompare
+  // A set of Action nodes from which the node with the largest sequence number can be popped.
+  //
+  // Sequence numbers are dense and, like the actions in an ActionSet, limited
+  // to 64; so one bit per sequence number suffices. Inserting, erasing and
+  // popping the node with the largest sequence number are O(1) and never allocate.
+  class SequenceNumberQueue
   {
-    bool operator()(Action* action1, Action* action2)
+   public:
+    static constexpr size_t max_nodes = 64;
+
+   private:
+    uint64_t m_pending;                         // Bit n is set when the node with sequence number n is queued.
+    std::array<Action*, max_nodes> m_nodes;     // The queued nodes, using the sequence number as index.
+
+    static uint64_t bit(Action* action)
+    {
+      size_t const n = action->sequence_number().get_value();
+      ASSERT(n < max_nodes);
+      return uint64_t{1} << n;
+    }
+
+   public:
+    SequenceNumberQueue() : m_pending(0) { }
+
+    bool empty() const { return m_pending == 0; }
+
+    // Returns false if action was already queued.
+    bool insert(Action* action)
+    {
+      uint64_t const b = bit(action);
+      bool const inserted = !(m_pending & b);
+      m_nodes[action->sequence_number().get_value()] = action;
+      m_pending |= b;
+      return inserted;
+    }
+
+    // Returns false if action wasn't queued.
+    bool erase(Action* action)
+    {
+      uint64_t const b = bit(action);
+      bool const erased = m_pending & b;
+      m_pending &= ~b;
+      return erased;
+    }
+
+    // Remove and return the node with the largest sequence number. The queue may not be empty.
+    Action* pop()
     {
-      return action1->sequence_number() > action2->sequence_number();
+      int const n = 63 - __builtin_clzll(m_pending);
+      m_pending &= ~(uint64_t{1} << n);
+      return m_nodes[n];
     }
   };
-  using queued_type = std::set<Action*, SequenceNumberCompare>;
+  using queued_type = SequenceNumberQueue;
 
  private:
+  VisitedEdges& m_visited_edges;
   int m_visited_generation;
   queued_type m_queued;
   Action* m_read_node;
 
  public:
-  FollowVisitedOpsemHeads(Action* read_node, int visited_generation) :
-      m_visited_generation(visited_generation), m_queued{read_node}, m_read_node(read_node) { }
+  FollowVisitedOpsemHeads(Action* read_node, VisitedEdges& visited_edges, int visited_generation) :
+      m_visited_edges(visited_edges), m_visited_generation(visited_generation), m_read_node(read_node) { m_queued.insert(read_node); }
 
-  void process_queued(std::function<bool(Action*, boolean::Expression&&)> const& if_found);
+  // Call `bool IF_FOUND::operator()(Action*, boolean::Expression&&) const' for every write (or read) found upstream.
+  template<class IF_FOUND>
+  void process_queued(IF_FOUND const& if_found);
 
   // Should we follow the edge of this end_point, that is only reached when path_condition?
   // Returns true and adjusts path_condition if so.
   bool operator()(EndPoint const& end_point, boolean::Expression& path_condition);
 };
+
+template<class IF_FOUND>
+void FollowVisitedOpsemHeads::process_queued(IF_FOUND const& if_found)
+{
+  while (!m_queued.empty())
+  {
+    Action* action = m_queued.pop();
+    FilterLocation const filter_location(m_read_node->location());
+    Dout(dc::notice, "Processing next queued action " << action->name() << ':');
+    boolean::Expression path_condition{action->calculate_path_condition(m_visited_edges, m_visited_generation, m_read_node)};
+    action->for_actions(*this, filter_location, if_found, path_condition);
+  }
+}
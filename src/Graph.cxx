@@ -7,6 +7,7 @@
 #include "iomanip_html.h"
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
 
 void Graph::new_edge(EdgeType edge_type, NodePtr const& tail_node, NodePtr const& head_node, Condition const& condition)
 {
@@ -26,6 +27,15 @@ void Graph::new_edge(EdgeType edge_type, NodePtr const& tail_node, NodePtr const
   }
 }
 
+namespace {
+
+int const fontsize = 14;
+int const edge_label_fontsize = 10;
+double const xscale = 2.0;
+double const yscale = 1.0;
+
+} // namespace
+
 void Graph::generate_dot_file(
     std::string const& filename,
     TopologicalOrderedActions const& topological_ordered_actions,
@@ -42,6 +52,43 @@ void Graph::generate_dot_file(
     return;
   }
 
+  // Write a .dot file.
+  out << dotfile;
+  std::string uncached_legend_rows;
+  std::string const* legend_rows = &m_dot_legend_rows;
+  if (m_dot_prefix.empty())
+  {
+    // Nothing was cached (yet); generate everything.
+    write_dot_prefix(out, topological_ordered_actions);
+    std::ostringstream oss;
+    write_dot_legend_rows(oss);
+    uncached_legend_rows = oss.str();
+    legend_rows = &uncached_legend_rows;
+  }
+  else
+    out << m_dot_prefix;
+  // Only the witness edges differ per candidate.
+  write_dot_edges(out, edge_mask_witness, true);
+  write_dot_legend(out, *legend_rows, valid.is_one() ? std::string() : valid.as_html_string(), invalid.is_zero() ? std::string() : invalid.as_html_string());
+  out << "}\n";
+}
+
+void Graph::cache_dot_prefix(TopologicalOrderedActions const& topological_ordered_actions)
+{
+  DoutEntering(dc::notice, "Graph::cache_dot_prefix()");
+
+  std::ostringstream prefix;
+  prefix << dotfile;
+  write_dot_prefix(prefix, topological_ordered_actions);
+  m_dot_prefix = prefix.str();
+
+  std::ostringstream legend_rows;
+  write_dot_legend_rows(legend_rows);
+  m_dot_legend_rows = legend_rows.str();
+}
+
+void Graph::write_dot_prefix(std::ostream& out, TopologicalOrderedActions const& topological_ordered_actions) const
+{
   int max_count = 0;
   utils::Vector<int, SequenceNumber> vertical_position;                         // As function of sequence number.
   std::vector<int> pos_of_last_node(Context::instance().number_of_threads(), -1);               // Position of last node of a thread as function of thread id.
@@ -74,13 +121,6 @@ void Graph::generate_dot_file(
     max_count = std::max(max_count, pos);
   }
 
-  int const fontsize = 14;
-  int const edge_label_fontsize = 10;
-  double const xscale = 2.0;
-  double const yscale = 1.0;
-
-  // Write a .dot file.
-  out << dotfile;
   out << "digraph G {\n";
   out << " splines=true;\n";
   out << " overlap=false;\n";
@@ -104,6 +144,12 @@ void Graph::generate_dot_file(
     out << *node << "\", pos=\"" << posx << ',' << posy << "!\"]"
         " [margin=\"0.0,0.0\"][fixedsize=\"true\"][height=\"" << (yscale * 0.25) << "\"][width=\"" << (xscale * 0.6) << "\"];\n";
   }
+  // All edges that are the same for every candidate.
+  write_dot_edges(out, edge_mask_witness, false);
+}
+
+void Graph::write_dot_edges(std::ostream& out, EdgeMaskType edge_mask, bool in_mask) const
+{
   for (NodePtr node{m_nodes.begin()}; node != m_nodes.end(); ++node)
   {
     //Dout(dc::notice, "LOOP: " << *node);
@@ -111,98 +157,111 @@ void Graph::generate_dot_file(
     {
       //Dout(dc::notice, "END-POINT: " << end_point);
 
-      if (*end_point.other_node() < *node)
+      if (*end_point.other_node() < *node || (end_point.edge_type() & edge_mask) != in_mask)
         continue;
 
-      std::string color = edge_color(end_point.edge_type());
       Edge* edge = end_point.edge();
       Action const* tail_node = ((end_point.type() == tail) ? &*node : end_point.other_node());
       Action const* head_node = ((end_point.type() == tail) ? end_point.other_node() : &*node);
-      out << "node" << tail_node->name() << " -> "
-             "node" << head_node->name() <<
-             " [label=<<font color=\"" << color << "\">" << edge->name();
-#ifdef CWDEBUG
-      // Print id of the edge to show in what order edges have been created.
-      out << edge->id();
-#endif
-      if (edge->is_conditional())
-        out << ':' << edge->condition().as_html_string();
-      out << "</font>>, color=\"" << color << "\", fontname=\"Helvetica\", "
-               "fontsize=" << edge_label_fontsize << ", penwidth=1., ";
-      if (edge->is_directed())
-        out << "arrowsize=\"0.8\"";
-      else
-        out << "constraint=false, arrowhead=\"none\"";
-      out << "];\n";
+      write_dot_edge(out, tail_node, head_node, edge->edge_type(), edge->condition() COMMA_DEBUG_ONLY(edge->id()));
     }
   }
+}
 
-  conditionals_type const& conditionals{Context::instance().conditionals()};
+//static
+void Graph::write_dot_edge(std::ostream& out, Action const* tail_node, Action const* head_node,
+    EdgeType edge_type, boolean::Expression const& condition COMMA_DEBUG_ONLY(int id))
+{
+  std::string color = edge_color(edge_type);
+  out << "node" << tail_node->name() << " -> "
+         "node" << head_node->name() <<
+         " [label=<<font color=\"" << color << "\">" << edge_name(edge_type);
+#ifdef CWDEBUG
+  // Print id of the edge to show in what order edges have been created.
+  if (id >= 0)
+    out << id;
+#endif
+  if (!condition.is_one())
+    out << ':' << condition.as_html_string();
+  out << "</font>>, color=\"" << color << "\", fontname=\"Helvetica\", "
+           "fontsize=" << edge_label_fontsize << ", penwidth=1., ";
+  if (EdgeMaskType{edge_type}.is_directed())
+    out << "arrowsize=\"0.8\"";
+  else
+    out << "constraint=false, arrowhead=\"none\"";
+  out << "];\n";
+}
+
+void Graph::write_dot_legend_rows(std::ostream& out) const
+{
+  for (auto&& conditional : Context::instance().conditionals())
+  {
+    out <<
+      "      <TR>\n"
+      "      <TD>" << conditional.second.id_name() << "</TD>\n"
+      "      <TD><FONT COLOR=\"black\">";
+    out << html << *conditional.first;
+    out <<
+      "</FONT></TD>\n"
+      "      </TR>\n";
+  }
   RSIndex const rs_begin = Context::instance().m_release_sequences.ibegin();
   RSIndex const rs_end = Context::instance().m_release_sequences.iend();
-  if (!conditionals.empty() || rs_begin != rs_end)
+  for (RSIndex rs_index = rs_begin; rs_index != rs_end; ++rs_index)
   {
+    ReleaseSequence const& release_sequence{Context::instance().m_release_sequences[rs_index]};
     out <<
-        "  { rank = sink;\n"
-        "     Legend [shape=none, margin=0, pos=\"1.0," << (1.0 - 1.5 * yscale) << "!\", label=<\n"
-        "     <TABLE BORDER=\"0\" CELLBORDER=\"1\" CELLSPACING=\"0\" CELLPADDING=\"4\">\n"
-        "      <TR>\n"
-        "       <TD COLSPAN=\"2\"><FONT face=\"Helvetica\"><B>Conditions</B></FONT></TD>\n"
-        "      </TR>\n";
-
-    for (auto&& conditional : conditionals)
-    {
-      out <<
-        "      <TR>\n"
-        "      <TD>" << conditional.second.id_name() << "</TD>\n"
-        "      <TD><FONT COLOR=\"black\">";
-      out << html << *conditional.first;
-      out <<
-        "</FONT></TD>\n"
-        "      </TR>\n";
-    }
-    for (RSIndex rs_index = rs_begin; rs_index != rs_end; ++rs_index)
-    {
-      ReleaseSequence const& release_sequence{Context::instance().m_release_sequences[rs_index]};
-      out <<
-        "      <TR>\n"
-        "      <TD>" << boolean::Product(release_sequence.boolexpr_variable()).to_string(true) << "</TD>\n"
-        "      <TD><FONT COLOR=\"black\">";
-      out << "RS " << release_sequence.m_begin << "--&gt;" << release_sequence.m_end;
-      out <<
-        "</FONT></TD>\n"
-        "      </TR>\n";
-    }
-    if (!valid.is_one())
-    {
-      out <<
-        "      <TR>\n"
-        "      <TD>Valid</TD>\n"
-        "      <TD><FONT COLOR=\"black\">";
-      out << valid.as_html_string();
-      out <<
-        "</FONT></TD>\n"
-        "      </TR>\n";
-    }
-    if (!invalid.is_zero())
-    {
-      out <<
-        "      <TR>\n"
-        "      <TD>Invalid</TD>\n"
-        "      <TD><FONT COLOR=\"black\">";
-      out << invalid.as_html_string();
-      out <<
-        "</FONT></TD>\n"
-        "      </TR>\n";
-    }
-
+      "      <TR>\n"
+      "      <TD>" << boolean::Product(release_sequence.boolexpr_variable()).to_string(true) << "</TD>\n"
+      "      <TD><FONT COLOR=\"black\">";
+    out << "RS " << release_sequence.m_begin << "--&gt;" << release_sequence.m_end;
     out <<
-        "     </TABLE>\n"
-        "    >];\n"
-        "  }\n";
+      "</FONT></TD>\n"
+      "      </TR>\n";
   }
+}
 
-  out << "}\n";
+//static
+void Graph::write_dot_legend(std::ostream& out, std::string const& legend_rows, std::string const& valid_html, std::string const& invalid_html)
+{
+  // Only print a legend when there are conditionals or release sequences.
+  if (legend_rows.empty())
+    return;
+
+  out <<
+      "  { rank = sink;\n"
+      "     Legend [shape=none, margin=0, pos=\"1.0," << (1.0 - 1.5 * yscale) << "!\", label=<\n"
+      "     <TABLE BORDER=\"0\" CELLBORDER=\"1\" CELLSPACING=\"0\" CELLPADDING=\"4\">\n"
+      "      <TR>\n"
+      "       <TD COLSPAN=\"2\"><FONT face=\"Helvetica\"><B>Conditions</B></FONT></TD>\n"
+      "      </TR>\n";
+  out << legend_rows;
+  if (!valid_html.empty())
+  {
+    out <<
+      "      <TR>\n"
+      "      <TD>Valid</TD>\n"
+      "      <TD><FONT COLOR=\"black\">";
+    out << valid_html;
+    out <<
+      "</FONT></TD>\n"
+      "      </TR>\n";
+  }
+  if (!invalid_html.empty())
+  {
+    out <<
+      "      <TR>\n"
+      "      <TD>Invalid</TD>\n"
+      "      <TD><FONT COLOR=\"black\">";
+    out << invalid_html;
+    out <<
+      "</FONT></TD>\n"
+      "      </TR>\n";
+  }
+  out <<
+      "     </TABLE>\n"
+      "    >];\n"
+      "  }\n";
 }
 
 #ifdef CWDEBUG
@@ -8,6 +8,10 @@
 #include <memory>
 #include <set>
 #include <stack>
+#include <string>
+#include <iosfwd>
+
+class DotRenderer;
 
 class Graph
 {
@@ -17,17 +21,19 @@ class Graph
  private:
   nodes_type m_nodes;                   // All nodes, ordered by Node::m_id.
   Action::id_type m_next_node_id;       // The id to use for the next node.
+  std::string m_dot_prefix;             // The cached start of the dot file: header, nodes and all non-witness edges.
+  std::string m_dot_legend_rows;        // The cached rows of the legend with the conditionals and release sequences.
 
  public:
   Graph() :
     m_next_node_id{0} { }
 
-  template <class FOLLOW, class FILTER>
+  template <class FOLLOW, class FILTER, class IF_FOUND>
   void for_actions_no_condition(// Starting with the first Action of the program call if_found(action) when filter returns true;
       FOLLOW follow,            // If if_found() does not return true, then follow each of its EndPoints when
                                 //  `bool FOLLOW::operator()(EndPoint const&)` returns true and repeat.
       FILTER filter,            // Call if_found() for this Action when `bool FILTER::operator()(Action const&)` returns true.
-      std::function<bool(Action*)> const& if_found) const
+      IF_FOUND const& if_found) const   // Called as `bool IF_FOUND::operator()(Action*) const'.
   {
     if (m_nodes.empty())
       return;
@@ -43,14 +49,29 @@ class Graph
       boolean::Expression const& valid,
       boolean::Expression const& invalid) const;
 
+  // Render the part of the dot file that is the same for every candidate.
+  // Call this after all non-witness edges were added; generate_dot_file then only has to add the witness edges.
+  void cache_dot_prefix(TopologicalOrderedActions const& topological_ordered_actions);
+
   void write_png_file(
+      DotRenderer& renderer,
       std::string basename,
       TopologicalOrderedActions const& topological_ordered_actions,
       boolean::Expression const& valid,
       boolean::Expression const& invalid,
       int appendix = -1) const;
 
+  // Write one edge in dot format. If id is non-negative then, in debug mode, it is printed as part of the label.
+  static void write_dot_edge(std::ostream& out, Action const* tail_node, Action const* head_node,
+      EdgeType edge_type, boolean::Expression const& condition COMMA_DEBUG_ONLY(int id = -1));
+
+  // Write the legend of a dot file. Nothing is written when legend_rows is empty.
+  // The Valid and Invalid rows are only added when the respective html string isn't empty.
+  static void write_dot_legend(std::ostream& out, std::string const& legend_rows, std::string const& valid_html, std::string const& invalid_html);
+
   // Accessor.
+  std::string const& dot_prefix() const { return m_dot_prefix; }
+  std::string const& dot_legend_rows() const { return m_dot_legend_rows; }
   nodes_type::iterator begin() { return m_nodes.begin(); }
   nodes_type::const_iterator begin() const { return m_nodes.begin(); }
   nodes_type::const_iterator end() const { return m_nodes.end(); }
@@ -86,4 +107,9 @@ class Graph
     for (auto&& action_ptr : m_nodes)
       action_ptr->delete_endpoints(edge_type);
   }
+
+ private:
+  void write_dot_prefix(std::ostream& out, TopologicalOrderedActions const& topological_ordered_actions) const;
+  void write_dot_edges(std::ostream& out, EdgeMaskType edge_mask, bool in_mask) const;
+  void write_dot_legend_rows(std::ostream& out) const;
 };
@@ -0,0 +1,179 @@
+#include "sys.h"
+#include "LocationClusters.h"
+#include "Action.h"
+#include "Thread.h"
+#include "debug.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <ostream>
+#include <set>
+
+namespace {
+
+using mask_type = uint64_t;     // A set of RFLocation indices.
+
+mask_type constexpr bit(size_t index) { return mask_type{1} << index; }
+
+} // namespace
+
+LocationClusters::LocationClusters(TopologicalOrderedActions const& topological_ordered_actions,
+    utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector)
+{
+  DoutEntering(dc::notice, "LocationClusters::LocationClusters(...)");
+
+  size_t const number_of_locations = read_from_location_subgraphs_vector.size();
+  // Every location with a ReadFrom edge has at least one read action, and there are at most 64 actions.
+  ASSERT(number_of_locations <= 64);
+
+  // Map every action to the index of its location, or -1 if that location has no ReadFrom edges.
+  utils::Vector<int, SequenceNumber> location_index(topological_ordered_actions.size(), -1);
+  for (SequenceNumber n = topological_ordered_actions.ibegin(); n != topological_ordered_actions.iend(); ++n)
+    for (RFLocation location = read_from_location_subgraphs_vector.ibegin(); location != read_from_location_subgraphs_vector.iend(); ++location)
+      if (topological_ordered_actions[n]->location() == read_from_location_subgraphs_vector[location].location())
+      {
+        location_index[n] = location.get_value();
+        break;
+      }
+
+  // The relations between locations that make up a path as described in the header, with ⇝ the sequenced-before relation:
+  std::vector<mask_type> action_to_write(number_of_locations);  // Y is in action_to_write[X] if a ⇝ w, for some action a of X and write w of Y.
+  std::vector<mask_type> read_to_action(number_of_locations);   // Y is in read_to_action[X] if r ⇝ b, for some read r of X and action b of Y.
+  std::vector<mask_type> read_to_write(number_of_locations);    // Y is in read_to_write[X] if r ⇝ w, for some read r of X and write w of Y.
+  for (SequenceNumber n1 = topological_ordered_actions.ibegin(); n1 != topological_ordered_actions.iend(); ++n1)
+  {
+    int const x = location_index[n1];
+    if (x == -1)
+      continue;
+    Action const& action1{*topological_ordered_actions[n1]};
+    for (SequenceNumber n2 = topological_ordered_actions.ibegin(); n2 != topological_ordered_actions.iend(); ++n2)
+    {
+      int const y = location_index[n2];
+      if (y == -1 || y == x)
+        continue;
+      Action const& action2{*topological_ordered_actions[n2]};
+      if (!action1.is_sequenced_before(action2))
+        continue;
+      if (action2.is_write())
+        action_to_write[x] |= bit(y);
+      if (action1.is_read())
+      {
+        read_to_action[x] |= bit(y);
+        if (action2.is_write())
+          read_to_write[x] |= bit(y);
+      }
+    }
+  }
+
+  // The reflexive, transitive closure of read_to_write: the locations whose rf edges can be passed one after another.
+  std::vector<mask_type> passes(number_of_locations);
+  for (size_t x = 0; x < number_of_locations; ++x)
+    passes[x] = read_to_write[x] | bit(x);
+  for (size_t k = 0; k < number_of_locations; ++k)
+    for (size_t x = 0; x < number_of_locations; ++x)
+      if ((passes[x] & bit(k)))
+        passes[x] |= passes[k];
+
+  // entered[L]: the locations M that can be reached from an action of L (a_L ⇝ ... →rf r_M).
+  // returns[M]: the locations L that can be reached from a read of M (r_M ⇝ ... ⇝ b_L).
+  std::vector<mask_type> entered(number_of_locations);
+  std::vector<mask_type> returns(number_of_locations);
+  for (size_t x = 0; x < number_of_locations; ++x)
+    for (size_t y = 0; y < number_of_locations; ++y)
+    {
+      if ((action_to_write[x] & bit(y)))
+        entered[x] |= passes[y];
+      if ((passes[x] & bit(y)))
+        returns[x] |= read_to_action[y];
+    }
+
+  // Put L and M in the same cluster if a path from L passes the rf edges of M and returns to L.
+  std::vector<size_t> parent(number_of_locations);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](size_t x){ while (parent[x] != x) x = parent[x] = parent[parent[x]]; return x; };
+  for (size_t l = 0; l < number_of_locations; ++l)
+    for (size_t m = 0; m < number_of_locations; ++m)
+      if (m != l && (entered[l] & bit(m)) && (returns[m] & bit(l)))
+        parent[find(m)] = find(l);
+
+  std::vector<int> cluster_index(number_of_locations, -1);
+  for (RFLocation location = read_from_location_subgraphs_vector.ibegin(); location != read_from_location_subgraphs_vector.iend(); ++location)
+  {
+    size_t const root = find(location.get_value());
+    if (cluster_index[root] == -1)
+    {
+      cluster_index[root] = m_clusters.size();
+      m_clusters.emplace_back();
+    }
+    m_clusters[cluster_index[root]].push_back(location);
+  }
+}
+
+void LocationClusters::merge()
+{
+  cluster_type all_locations;
+  for (cluster_type const& cluster : m_clusters)
+    all_locations.insert(all_locations.end(), cluster.begin(), cluster.end());
+  std::sort(all_locations.begin(), all_locations.end());
+  m_clusters.clear();
+  if (!all_locations.empty())
+    m_clusters.push_back(std::move(all_locations));
+}
+
+void LocationClusters::order_most_constrained_first(TopologicalOrderedActions const& topological_ordered_actions,
+    utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector)
+{
+  struct Rank
+  {
+    size_t m_subgraphs;                 // The number of rf subgraphs of the location.
+    size_t m_threads;                   // The number of threads that access the location.
+    double m_synchronizing;             // The fraction of the actions on the location that are release, acquire or consume.
+  };
+
+  utils::Vector<Rank, RFLocation> ranks;
+  for (RFLocation location = read_from_location_subgraphs_vector.ibegin(); location != read_from_location_subgraphs_vector.iend(); ++location)
+  {
+    ReadFromLocationSubgraphs const& read_from_location_subgraphs{read_from_location_subgraphs_vector[location]};
+    std::set<Thread::id_type> threads;
+    size_t actions = 0;
+    size_t synchronizing = 0;
+    for (Action const* action : topological_ordered_actions)
+    {
+      if (!(action->location() == read_from_location_subgraphs.location()))
+        continue;
+      threads.insert(action->thread()->id());
+      ++actions;
+      if (action->is_release() || action->is_acquire() || action->is_consume())
+        ++synchronizing;
+    }
+    ranks.push_back({read_from_location_subgraphs.size(), threads.size(), static_cast<double>(synchronizing) / actions});
+  }
+
+  for (cluster_type& cluster : m_clusters)
+    std::stable_sort(cluster.begin(), cluster.end(), [&ranks](RFLocation location1, RFLocation location2){
+        Rank const& rank1{ranks[location1]};
+        Rank const& rank2{ranks[location2]};
+        if (rank1.m_subgraphs != rank2.m_subgraphs)
+          return rank1.m_subgraphs < rank2.m_subgraphs;
+        if (rank1.m_threads != rank2.m_threads)
+          return rank1.m_threads > rank2.m_threads;
+        return rank1.m_synchronizing > rank2.m_synchronizing;
+      });
+}
+
+void LocationClusters::print_on(std::ostream& os, utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector) const
+{
+  char const* separator = "";
+  for (cluster_type const& cluster : m_clusters)
+  {
+    os << separator << '{';
+    char const* location_separator = "";
+    for (RFLocation location : cluster)
+    {
+      os << location_separator << read_from_location_subgraphs_vector[location].location().name();
+      location_separator = " ";
+    }
+    os << '}';
+    separator = " ";
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ReadFromLocationSubgraphs.h"
+#include "RFLocationOrderedSubgraphs.h"
+#include "TopologicalOrderedActions.h"
+#include <iosfwd>
+#include <vector>
+
+// A partition of all memory locations with at least one ReadFrom edge into
+// clusters whose rf subgraphs can be chosen independently.
+//
+// An inconsistency that involves the rf edges of more than one location is
+// always a path (in the graph of sb, asw and rf edges) that begins and ends
+// at an action of the same location L, and that passes the rf edges of one or
+// more other locations M1, M2, ..., Mk:
+//
+//   a_L ⇝ w_M1 →rf r_M1 ⇝ w_M2 →rf r_M2 ⇝ ... ⇝ w_Mk →rf r_Mk ⇝ b_L
+//
+// where ⇝ is sequenced-before (including asw) and w_Mi, r_Mi are a write and a read of Mi.
+// All locations on such a path are put in the same cluster. Hence, the loop detection
+// of one cluster never depends on the rf subgraphs chosen for another cluster.
+//
+// Note that it is not enough that an action of L is sequenced before an action of M:
+// the initialization of every location in main() is sequenced before all other
+// actions, but a path starting there only involves M if it can return to L.
+//
+class LocationClusters
+{
+ public:
+  using cluster_type = std::vector<RFLocation>;
+  using container_type = std::vector<cluster_type>;
+  using const_iterator = container_type::const_iterator;
+
+ private:
+  container_type m_clusters;            // The clusters, ordered by their first location (by RFLocation).
+
+ public:
+  LocationClusters(TopologicalOrderedActions const& topological_ordered_actions,
+      utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector);
+
+  // Put all locations in a single cluster, in RFLocation order (to compare with the enumeration without clusters).
+  void merge();
+
+  // Reorder the locations of every cluster so that the most constrained locations come first
+  // (and thus become the outer loops of the enumeration): those with the fewest rf subgraphs,
+  // then those touched by the most threads, then those with the largest fraction of
+  // synchronizing (release, acquire or consume) actions.
+  void order_most_constrained_first(TopologicalOrderedActions const& topological_ordered_actions,
+      utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector);
+
+  // Accessors.
+  size_t size() const { return m_clusters.size(); }
+  cluster_type const& operator[](size_t index) const { return m_clusters[index]; }
+  const_iterator begin() const { return m_clusters.begin(); }
+  const_iterator end() const { return m_clusters.end(); }
+
+  // Print the names of the locations of every cluster, in order, for example "{flag data} {y}".
+  void print_on(std::ostream& os, utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector) const;
+};
@@ -0,0 +1,157 @@
+#include "sys.h"
+#include "NDJSONWriter.h"
+#include "DirectedSubgraph.h"
+#include "cppmem_analyzer.h"
+#include <ostream>
+
+void NDJSONWriter::begin_candidate(int candidate)
+{
+  m_os << "{\"candidate\":" << candidate << ",\"rf\":[";
+  m_first_edge = true;
+}
+
+void NDJSONWriter::add_rf_edges(DirectedSubgraph const& read_from_subgraph)
+{
+  for (DirectedEdge const& directed_edge : read_from_subgraph)
+  {
+    if (!m_first_edge)
+      m_os.put(',');
+    m_os << '[' << directed_edge.tail_sequence_number().get_value() << ',' << directed_edge.head_sequence_number().get_value() << ']';
+    m_first_edge = false;
+  }
+}
+
+void NDJSONWriter::end_candidate(boolean::Expression const& valid, boolean::Expression const& loop_condition, bool have_unsequenced_races)
+{
+  m_os << "],\"valid\":";
+  write_json_string(valid);
+  m_os << ",\"loop\":";
+  write_json_string(loop_condition);
+  m_os << ",\"races\":{\"unsequenced\":" << (have_unsequenced_races ? "true" : "false") << "}}\n";
+}
+
+void NDJSONWriter::write_duplicates(std::vector<int> const& candidates)
+{
+  m_os << "{\"graph\":" << candidates.front() << ",\"candidates\":[";
+  char const* separator = "";
+  for (int candidate : candidates)
+  {
+    m_os << separator << candidate;
+    separator = ",";
+  }
+  m_os << "]}\n";
+}
+
+void NDJSONWriter::write_test_summary(std::string const& filepath, int exit_code, int candidates, int distinct_graphs, bool have_unsequenced_races, bool cached)
+{
+  m_os << "{\"test\":";
+  write_json_string(filepath);
+  m_os << ",\"exit\":" << exit_code << ",\"candidates\":" << candidates << ",\"distinct\":" << distinct_graphs <<
+    ",\"unsequenced\":" << (have_unsequenced_races ? "true" : "false") << ",\"cached\":" << (cached ? "true" : "false") << "}\n";
+}
+
+void NDJSONWriter::write_result(cppmem::Result const& result)
+{
+  if (!result.success)
+  {
+    m_os << "{\"exit\":1,\"error\":";
+    write_json_string(result.error);
+    m_os << "}\n";
+    return;
+  }
+  m_os << "{\"exit\":0,\"candidates\":" << result.statistics.candidates << ",\"distinct\":" << result.statistics.distinct_graphs << ",\"unsequenced\":[";
+  char const* separator = "";
+  for (cppmem::UnsequencedRace const& race : result.unsequenced_races)
+  {
+    m_os << separator << '[' << race.first << ',' << race.second << ']';
+    separator = ",";
+  }
+  m_os << "],\"executions\":[";
+  separator = "";
+  for (cppmem::Execution const& execution : result.executions)
+  {
+    if (execution.same_as != execution.candidate)
+      continue;
+    m_os << separator << "{\"candidate\":" << execution.candidate << ",\"rf\":[";
+    char const* edge_separator = "";
+    for (cppmem::RFEdge const& edge : execution.rf)
+    {
+      m_os << edge_separator << '[' << edge.first << ',' << edge.second << ']';
+      edge_separator = ",";
+    }
+    m_os << "],\"valid\":";
+    write_json_string(execution.valid);
+    m_os << ",\"loop\":";
+    write_json_string(execution.loop);
+    m_os << '}';
+    separator = ",";
+  }
+  m_os << "]}\n";
+}
+
+void NDJSONWriter::write_profile(std::string const& filepath, cppmem::Profile const& profile)
+{
+  m_os << "{\"test\":";
+  write_json_string(filepath);
+  for (int phase = 0; phase <= cppmem::number_of_phases; ++phase)
+  {
+    bool const is_total = phase == cppmem::number_of_phases;
+    cppmem::PhaseProfile const phase_profile = is_total ? profile.total() : profile.phases[phase];
+    m_os << ",\"" << (is_total ? "total" : cppmem::phase_name(static_cast<cppmem::Phase>(phase))) << "\":{\"seconds\":" << phase_profile.seconds;
+    // Leave out the allocations when they were not counted (debug builds), rather than reporting zero.
+    if (profile.allocations_counted)
+      m_os << ",\"allocations\":" << phase_profile.allocations << ",\"bytes\":" << phase_profile.bytes;
+    m_os << '}';
+  }
+  m_os << "}\n";
+}
+
+void NDJSONWriter::flush()
+{
+  m_os.flush();
+}
+
+void NDJSONWriter::write_json_string(boolean::Expression const& expression)
+{
+  // Reuse the scratch buffer for every expression.
+  m_scratch.str(std::string());
+  m_scratch << expression;
+  write_json_string(m_scratch.str());
+}
+
+//static
+void NDJSONWriter::write_json_string(std::ostream& os, std::string const& str)
+{
+  os.put('"');
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\r':
+        os << "\\r";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          // All other control characters must be escaped too (RFC 8259).
+          static char const hex_digits[] = "0123456789abcdef";
+          os << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+        }
+        else
+          os.put(c);
+    }
+  }
+  os.put('"');
+}
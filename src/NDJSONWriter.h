@@ -0,0 +1,76 @@
+#pragma once
+
+#include "boolean-expression/BooleanExpression.h"
+#include <iosfwd>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class DirectedSubgraph;
+
+namespace cppmem {
+struct Result;
+struct Profile;
+} // namespace cppmem
+
+// Write one compact JSON record per line (newline-delimited JSON) for every rf candidate.
+//
+// A record looks like (but without the newlines):
+//
+//   {"candidate":3,
+//    "rf":[[2,5],[7,9]],
+//    "valid":"A'",
+//    "loop":"0",
+//    "races":{"unsequenced":false}}
+//
+// where every rf edge is written as [write, read], using the (zero based)
+// SequenceNumber of the respective Action nodes.
+//
+// All output goes to the single (buffered) stream passed to the constructor.
+// Edges are streamed directly from the subgraphs, nothing is allocated per edge.
+//
+class NDJSONWriter
+{
+ private:
+  std::ostream& m_os;                   // The output stream.
+  std::ostringstream m_scratch;         // Used to format boolean expressions before escaping them.
+  bool m_first_edge;                    // True until the first rf edge of the current record was written.
+
+ public:
+  NDJSONWriter(std::ostream& os) : m_os(os), m_first_edge(true) { }
+
+  // Start a new record for candidate number `candidate'.
+  void begin_candidate(int candidate);
+
+  // Add all rf edges of a read-from subgraph to the current record.
+  void add_rf_edges(DirectedSubgraph const& read_from_subgraph);
+
+  // Finish the current record.
+  void end_candidate(boolean::Expression const& valid, boolean::Expression const& loop_condition, bool have_unsequenced_races);
+
+  // Write a record {"graph":3,"candidates":[3,7,9]} listing all candidates that are the same graph as the (output) first one.
+  void write_duplicates(std::vector<int> const& candidates);
+
+  // Write a record {"test":"test1.c","exit":0,"candidates":12,"distinct":9,"unsequenced":false,"cached":false} summarizing the analysis of one test (batch mode).
+  void write_test_summary(std::string const& filepath, int exit_code, int candidates, int distinct_graphs, bool have_unsequenced_races, bool cached);
+
+  // Write a record with the whole result of one analysis (--serve), for example:
+  // {"exit":0,"candidates":3,"distinct":2,"unsequenced":[],"executions":[{"candidate":0,"rf":[[2,5]],"valid":"1","loop":"0"},...]}
+  // Only the first candidate of every distinct graph is listed. A failed analysis results in {"exit":1,"error":"..."}.
+  void write_result(cppmem::Result const& result);
+
+  // Write a record with the resources used by every phase of the analysis of one test (--profile), for example:
+  // {"test":"test1.c","parse":{"seconds":0.00012,"allocations":310,"bytes":24816},...,"total":{"seconds":0.0023,"allocations":5120,"bytes":401208}}
+  // The allocations and bytes are left out if they were not counted (see AllocationCounter.h).
+  void write_profile(std::string const& filepath, cppmem::Profile const& profile);
+
+  // Flush the output stream.
+  void flush();
+
+  // Write str to os as a JSON string: between double quotes, with all special and control characters escaped.
+  static void write_json_string(std::ostream& os, std::string const& str);
+
+ private:
+  void write_json_string(boolean::Expression const& expression);
+  void write_json_string(std::string const& str) { write_json_string(m_os, str); }
+};
@@ -5,13 +5,13 @@
 bool Propagator::rf_acq_but_not_rel() const
 {
   ASSERT(!m_edge_is_rf || m_current_is_write);
-  return m_edge_is_rf && m_child_action->is_acquire() && !m_current_action->is_release();
+  return m_edge_is_rf && m_child_action->acts_as_acquire() && !m_current_action->is_release();
 }
 
 bool Propagator::rf_rel_acq() const
 {
   ASSERT(!m_edge_is_rf || m_current_is_write);
-  return m_edge_is_rf && m_child_action->is_acquire() && m_current_action->is_release();
+  return m_edge_is_rf && m_child_action->acts_as_acquire() && m_current_action->is_release();
 }
 
 bool Propagator::is_write_rel_to(RFLocation location) const
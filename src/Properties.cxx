@@ -1,6 +1,7 @@
 #include "sys.h"
 #include "Properties.h"
 #include "ReadFromGraph.h"
+#include "Stats.h"
 
 void Properties::add(Property&& new_property)
 {
@@ -16,6 +17,7 @@ void Properties::merge(
     ReadFromGraph const* read_from_graph)
 {
   DoutEntering(dc::property, "Properties::merge(" << properties << ", " << propagator << ", read_from_graph)");
+  stats::increment(stats::properties_merge);
   if (propagator.rf_acq_but_not_rel())
   {
     Dout(dc::property, "Unsynced Release-Sequence detected.");
@@ -33,6 +35,7 @@ void Properties::merge(
     if (property.is_relevant(*read_from_graph))
     {
       // Create a new Property in m_map from property but with already updated path condition.
+      stats::increment(stats::expression_times);
       Property new_property(property, property.path_condition().times(propagator.condition()));
       // Then apply the propagator to the rest of the data.
       if (new_property.convert(propagator) && !new_property.if_needed_unwrap_to(*this, propagator.current_node()))
@@ -64,6 +67,7 @@ boolean::Expression Properties::current_loop_condition(ReadFromGraph const* read
     if (property.invalidates_graph(read_from_graph))
     {
       Dout(dc::readfrom, "Property " << property << " invalidates graph under condition " << property.path_condition() << '.');
+      stats::increment(stats::expression_plus);
       invalid_condition += property.path_condition();
     }
   return invalid_condition;
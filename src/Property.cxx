@@ -3,6 +3,7 @@
 #include "ReadFromGraph.h"
 #include "ReleaseSequence.h"
 #include "Context.h"
+#include "Stats.h"
 
 // A hidden visual side effect means that there is a Read-From that reads from
 // a write whose side effect is hidden by another write to the same memory
@@ -233,6 +234,7 @@ bool Property::convert(Propagator const& propagator)
       if (!m_location.undefined() && m_location != propagator.current_location())
       {
         Dout(dc::property, "Returning false because causal loop follows non-rel-acq rf for second memory location.");
+        stats::increment(stats::property_convert_dropped);
         return false;
       }
       Dout(dc::property, "Read-From edge is not rel-acq: setting m_location of causal_loop Property to " << propagator.current_location() << '.');
@@ -244,6 +246,7 @@ bool Property::convert(Propagator const& propagator)
     if (propagator.rf_acq_but_not_rel())        // Should we wrap all Property objects instead of copying them?
     {
       Dout(dc::property, "Returning false because reads_from should not be propagated over a non-rel-acq rf (but wrapped).");
+      stats::increment(stats::property_convert_dropped);
       return false;
     }
     if (propagator.is_write() && m_location == propagator.current_location() && m_end_point != propagator.current_node())
@@ -268,11 +271,13 @@ bool Property::convert(Propagator const& propagator)
       Dout(dc::property, "Recording the current thread (" << propagator.current_thread() << ") as the thread that writes.");
       ASSERT(m_release_sequence_thread == -1);
       m_release_sequence_thread = propagator.current_thread();
+      stats::increment(stats::property_convert_kept);
       return true;
     }
     else if (propagator.rf_acq_but_not_rel())   // Should we wrap all Property objects instead of copying them?
     {
       Dout(dc::property, "Returning false because release_sequence should not be propagated over a non-rel-acq rf (but wrapped).");
+      stats::increment(stats::property_convert_dropped);
       return false;
     }
     // m_location should always be defined when we get here.
@@ -302,6 +307,7 @@ bool Property::convert(Propagator const& propagator)
       }
     }
   }
+  stats::increment(stats::property_convert_kept);
   return true;
 }
 
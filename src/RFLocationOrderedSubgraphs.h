@@ -10,5 +10,7 @@ struct RFLocation;        // All memory locations with at least one ReadFrom edg
 
 using RFLocation = utils::VectorIndex<ordering_category::RFLocation>;
 using RFLocationOrderedSubgraphs = utils::Vector<DirectedSubgraph const*, RFLocation>;
+// The index of the chosen ReadFrom subgraph of every memory location.
+using RFLocationSubgraphIndices = utils::Vector<int, RFLocation>;
 
 std::ostream& operator<<(std::ostream& os, RFLocation index);
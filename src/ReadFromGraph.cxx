@@ -4,6 +4,7 @@
 #include "Action.h"
 #include "Context.h"
 #include "Propagator.h"
+#include "Stats.h"
 #include "utils/MultiLoop.h"
 
 ReadFromGraph::ReadFromGraph(
@@ -11,9 +12,10 @@ ReadFromGraph::ReadFromGraph(
     EdgeMaskType outgoing_type,
     EdgeMaskType incoming_type,
     TopologicalOrderedActions const& topological_ordered_actions,
-    std::vector<ReadFromLocationSubgraphs> const& read_from_location_subgraphs_vector) :
+    std::vector<ReadFromLocationSubgraphs> const& read_from_location_subgraphs_vector,
+    std::vector<RFLocation> const& locations) :
       DirectedSubgraph(graph, outgoing_type, incoming_type, boolean::Expression{true}),
-      m_number_of_nodes(m_nodes.size()),
+      m_number_of_nodes(number_of_nodes()),
       m_generation(0),
       m_node_data(m_number_of_nodes),
       m_topological_ordered_actions(topological_ordered_actions),
@@ -23,13 +25,13 @@ ReadFromGraph::ReadFromGraph(
   RFLocation index{m_current_subgraphs.ibegin()};
   push(*this);
   // Initialize m_location_id_to_rf_location.
-  for (auto&& location_subgraphs : read_from_location_subgraphs_vector)
+  for (RFLocation location : locations)
   {
+    auto&& location_subgraphs = read_from_location_subgraphs_vector[location.get_value()];
     Dout(dc::readfrom, location_subgraphs.location() << ':');
-    // Subgraphs from read_from_location_subgraphs_vector are pushed in order to m_current_subgraphs
-    // by calling push/pop. Therefore the n+1's subgraph in m_current_subgraphs always corresponds
-    // to the same memory location, namely the location of the n-th ReadFromLocationSubgraphs
-    // of read_from_location_subgraphs_vector. The +1 is because of the push(*this) above.
+    // Subgraphs of the locations are pushed in order to m_current_subgraphs by calling push/pop.
+    // Therefore the n+1's subgraph in m_current_subgraphs always corresponds to the same memory
+    // location, namely the n-th location of `locations'. The +1 is because of the push(*this) above.
     m_location_id_to_rf_location[location_subgraphs.location().tag().id] = ++index; // Preincement: we start at index 1.
 #ifdef CWDEBUG
     NAMESPACE_DEBUG::Indent indent(4);
@@ -44,6 +46,7 @@ ReadFromGraph::ReadFromGraph(
 boolean::Expression const& ReadFromGraph::loop_detected()
 {
   DoutEntering(dc::notice, "ReadFromGraph::loop_detected()");
+  stats::increment(stats::loop_detected_calls);
 
   // Node 0 is the starting node of the program.
   m_current_node.set_to_zero();
@@ -120,9 +123,81 @@ boolean::Expression const& ReadFromGraph::loop_detected()
 // exist when each edge is "weighted" (with a boolean expression in this case),
 // was designed by myself (Carlo Wood) in November/December 2017.
 //
+// The "calls" to dfs(n) above are not implemented as recursive calls:
+// every node that is being followed has a Frame on m_stack instead, so that
+// long chains of sequenced actions do not result in a deep C++ stack.
+// dfs() itself is the loop that runs over the edges of the node on top of
+// that stack; begin_node, follow_edge and end_node do the work that the
+// recursive function did before, after following and after returning from
+// a child respectively.
+//
 bool ReadFromGraph::dfs()
 {
-  DoutEntering(dc::readfrom, "ReadFromGraph::dfs() for node " << m_current_node << '.');
+  DoutEntering(dc::readfrom, "ReadFromGraph::dfs() for start node " << m_current_node << '.');
+  ASSERT(m_stack.empty());
+
+  begin_node();
+  bool have_properties = false;
+  for (;;)
+  {
+    Frame& frame{m_stack.back()};
+    m_current_node = frame.m_node;
+
+    if (frame.m_edge == frame.m_end)
+    {
+      // Next process the rf edges of the current node, if any.
+      if (frame.m_opsem_or_rf == 0 && frame.m_have_location_subgraph)
+      {
+        frame.m_opsem_or_rf = 1;
+        DirectedEdges const directed_edges = m_current_subgraphs[frame.m_location]->edges(m_current_node);
+        frame.m_edge = directed_edges.begin_outgoing();
+        frame.m_end = directed_edges.end_outgoing();
+        continue;
+      }
+      have_properties = end_node();
+      m_stack.pop_back();
+      if (m_stack.empty())
+        break;
+      // Return to the parent, whose current edge leads to the node that we just finished.
+      Frame& parent{m_stack.back()};
+      m_current_node = parent.m_node;
+      if (have_properties)
+        follow_edge(parent);
+      ++parent.m_edge;
+      continue;
+    }
+
+    SequenceNumber const child = frame.m_edge->head_sequence_number();
+    Dout(dc::readfrom, "Following edge to child " << child);
+    stats::increment(stats::dfs_edges_followed);
+
+    if (is_processed(child) || is_visited_but_not_relevant(child))
+    {
+      Dout(dc::readfrom, "  continuing because that node is already processed.");
+      ++frame.m_edge;
+      continue;
+    }
+    // If is_visited returns true then we have properties to be processed,
+    // because if there were no relevant properties then we wouldn't get here.
+    if (!is_followed(child) && !is_visited(child))
+    {
+      // "Call" dfs for child; this invalidates frame.
+      m_current_node = child;
+      begin_node();
+      continue;
+    }
+    follow_edge(frame);
+    ++frame.m_edge;
+  }
+
+  return have_properties;
+}
+
+// Start visiting node m_current_node: push a new Frame.
+void ReadFromGraph::begin_node()
+{
+  DoutEntering(dc::readfrom, "ReadFromGraph::begin_node() for node " << m_current_node << '.');
+  stats::increment(stats::dfs_node_visits);
 
   // Depth-First search only visits each node once.
   ASSERT(is_unvisited(m_current_node));
@@ -143,9 +218,9 @@ bool ReadFromGraph::dfs()
 
   if (is_read)
   {
-    DirectedSubgraph const* subgraph = m_current_subgraphs[current_location];
-    for (auto incoming_read_from_edge = subgraph->edges(m_current_node).begin_incoming();
-         incoming_read_from_edge != subgraph->edges(m_current_node).end_incoming();
+    DirectedEdges const read_from_edges = m_current_subgraphs[current_location]->edges(m_current_node);
+    for (auto incoming_read_from_edge = read_from_edges.begin_incoming();
+         incoming_read_from_edge != read_from_edges.end_incoming();
          ++incoming_read_from_edge)
     {
       SequenceNumber write_node{incoming_read_from_edge->tail_sequence_number()};
@@ -157,105 +232,87 @@ bool ReadFromGraph::dfs()
 
   set_followed(m_current_node);
 
-  // Run over all relevant subgraphs (two of them).
-  DirectedSubgraph const* subgraph = m_current_subgraphs.front();
-  for (int opsem_or_rf = 0; opsem_or_rf < 2; ++opsem_or_rf)     // 0: edge is opsem, 1: edge is rf.
-  {
-    // Run over all outgoing directed edges of the current node.
-    for (auto directed_edge = subgraph->edges(m_current_node).begin_outgoing(); directed_edge != subgraph->edges(m_current_node).end_outgoing(); ++directed_edge)
-    {
-      SequenceNumber const child = directed_edge->head_sequence_number();
-      Dout(dc::readfrom, "Following edge to child " << child);
+  // Run over all relevant subgraphs (two of them), starting with the outgoing opsem edges of the current node.
+  DirectedEdges const directed_edges = m_current_subgraphs.front()->edges(m_current_node);
+  m_stack.push_back({m_current_node, current_action, current_location, have_location_subgraph, is_write, 0,
+      directed_edges.begin_outgoing(), directed_edges.end_outgoing()});
+}
 
-      if (is_processed(child) || is_visited_but_not_relevant(child))
-      {
-        Dout(dc::readfrom, "  continuing because that node is already processed.");
-        continue;
-      }
-      if (!is_followed(child))
-      {
-        // If is_visited returns true then we have properties to be processed,
-        // because if there were no relevant properties then we wouldn't get here.
-        bool have_properties = is_visited(child);
-        if (!have_properties)
-        {
-          // Call dfs recursively.
-          SequenceNumber current_node{m_current_node};
-          m_current_node = child;
-          have_properties = dfs();
-          m_current_node = current_node;
-        }
-        if (!have_properties)
-          continue;
-      }
+// Process the current edge of frame, that is the current node, which leads to a child that
+// either is currently being followed or was visited before and has unprocessed properties.
+void ReadFromGraph::follow_edge(Frame const& frame)
+{
+  SequenceNumber const child = frame.m_edge->head_sequence_number();
+  Properties& current_properties{m_node_data[m_current_node].m_properties};
 
-      // If we are following an edge that is a ReadFrom then obviously the current node needs to be a write.
-      ASSERT(!opsem_or_rf || is_write);
+  // If we are following an edge that is a ReadFrom then obviously the current node needs to be a write.
+  ASSERT(!frame.m_opsem_or_rf || frame.m_is_write);
 
-      // We fould an edge that either ends in a (child) node that
-      // is currently being followed, or that was visited before
-      // and has unprocessed properties. In the latter case the
-      // properties of child need converted using a Propagator and
-      // merged into the properties of the current node.
-      // In the former case we create a new causal_loop property,
-      // which also has to be converted before it can be merged
-      // into our own properties.
-      //
-      //           opsem or rf              (opsem being sb or asw).
-      //    * ----------------------> *
-      //    ^                         ^
-      //    |                         |
-      // current_*                  child*
-      //
-      Propagator propagator(
-          current_action, m_current_node, current_location, is_write,
-          m_topological_ordered_actions[child], child, opsem_or_rf,
-          directed_edge->condition());
+  // We fould an edge that either ends in a (child) node that
+  // is currently being followed, or that was visited before
+  // and has unprocessed properties. In the latter case the
+  // properties of child need converted using a Propagator and
+  // merged into the properties of the current node.
+  // In the former case we create a new causal_loop property,
+  // which also has to be converted before it can be merged
+  // into our own properties.
+  //
+  //           opsem or rf              (opsem being sb or asw).
+  //    * ----------------------> *
+  //    ^                         ^
+  //    |                         |
+  // current_*                  child*
+  //
+  Propagator propagator(
+      frame.m_action, m_current_node, frame.m_location, frame.m_is_write,
+      m_topological_ordered_actions[child], child, frame.m_opsem_or_rf,
+      frame.m_edge->condition());
 
-      if (is_followed(child))
-      {
-        Dout(dc::readfrom, "  possible causal loop detected. Marking node " << child << " as end_point.");
-        // If the edge is a Read-From edge and the child is a Read acquire but
-        // our current node is not a Write release then we need to wrap the
-        // causal_loop Property in a release_sequence Property.
-        bool is_release_sequence = propagator.rf_acq_but_not_rel();
-        // Create a new causal_loop/release_sequence Property. Immediately give it the condition
-        // under which our edge exists because convert() does not alter the condition
-        // of Property objects, so we have to do that ourselves.
-        if (is_release_sequence)
-        {
-          Property rs_property(child, m_current_node, directed_edge->condition());
-          // In this case the new causal loop Property needs to be both, wrapped and added.
-          Property cl_property(child, true);
-          rs_property.wrap(cl_property);
-          if (cl_property.convert(propagator))
-            current_properties.add(std::move(cl_property));
-          if (rs_property.convert(propagator))
-            current_properties.add(std::move(rs_property));
-        }
-        else
-        {
-          Property cl_property(child, directed_edge->condition());
-          if (cl_property.convert(propagator))
-            current_properties.add(std::move(cl_property));
-        }
-        Dout(dc::readfrom, "  " << m_current_node << ".properties is now " << current_properties);
-      }
-      else
-      {
-        Dout(dc::readfrom, "  merging properties of child " << child << " [" << m_node_data[child].m_properties <<
-            "] into node " << m_current_node << " [" << current_properties << "].");
-        // Propagate the properties from child to the current node and merge them.
-        current_properties.merge(m_node_data[child].m_properties, std::move(propagator), this);
-        Dout(dc::readfrom, "  " << m_current_node << ".properties is now " << current_properties);
-      }
+  if (is_followed(child))
+  {
+    Dout(dc::readfrom, "  possible causal loop detected. Marking node " << child << " as end_point.");
+    // If the edge is a Read-From edge and the child is a Read acquire but
+    // our current node is not a Write release then we need to wrap the
+    // causal_loop Property in a release_sequence Property.
+    bool is_release_sequence = propagator.rf_acq_but_not_rel();
+    // Create a new causal_loop/release_sequence Property. Immediately give it the condition
+    // under which our edge exists because convert() does not alter the condition
+    // of Property objects, so we have to do that ourselves.
+    if (is_release_sequence)
+    {
+      Property rs_property(child, m_current_node, frame.m_edge->condition());
+      // In this case the new causal loop Property needs to be both, wrapped and added.
+      Property cl_property(child, true);
+      rs_property.wrap(cl_property);
+      if (cl_property.convert(propagator))
+        current_properties.add(std::move(cl_property));
+      if (rs_property.convert(propagator))
+        current_properties.add(std::move(rs_property));
+    }
+    else
+    {
+      Property cl_property(child, frame.m_edge->condition());
+      if (cl_property.convert(propagator))
+        current_properties.add(std::move(cl_property));
     }
-    // Next process the rf edges of the current node, if any.
-    if (!have_location_subgraph)
-      break;
-    subgraph = m_current_subgraphs[current_location];
+    Dout(dc::readfrom, "  " << m_current_node << ".properties is now " << current_properties);
   }
+  else
+  {
+    Dout(dc::readfrom, "  merging properties of child " << child << " [" << m_node_data[child].m_properties <<
+        "] into node " << m_current_node << " [" << current_properties << "].");
+    // Propagate the properties from child to the current node and merge them.
+    current_properties.merge(m_node_data[child].m_properties, std::move(propagator), this);
+    Dout(dc::readfrom, "  " << m_current_node << ".properties is now " << current_properties);
+  }
+}
+
+// Finish visiting node m_current_node, after all its children were followed.
+// Returns true if the node has properties (see dfs()).
+bool ReadFromGraph::end_node()
+{
   Dout(dc::readfrom, "Done following children of node " << m_current_node);
+  Properties& current_properties{m_node_data[m_current_node].m_properties};
   bool have_properties = !current_properties.empty();
   if (have_properties)
   {
@@ -264,6 +321,7 @@ bool ReadFromGraph::dfs()
     if (!loop_condition.is_zero())
     {
       Dout(dc::notice, "Violation(s) detected involving end point " << m_current_node << ", under condition " << loop_condition << '.');
+      stats::increment(stats::expression_plus);
       m_loop_condition += loop_condition;
       Dout(dc::readfrom, "m_loop_condition is now: " << m_loop_condition << '.');
     }
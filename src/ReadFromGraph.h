@@ -18,7 +18,7 @@ class ReadFromGraph : public DirectedSubgraph
   };
 
   SequenceNumber m_current_node;                                // The current node in the Depth-First-Search.
-  int const m_number_of_nodes;                                  // Copy of DirectedSubgraph::m_nodes.size().
+  int const m_number_of_nodes;                                  // Copy of DirectedSubgraph::number_of_nodes().
   set_type m_generation;                                        // The current generation.
   boolean::Expression m_loop_condition;                         // Collector for the total condition under which there is any loop.
   RFLocationOrderedSubgraphs m_current_subgraphs;               // List of subgraphs that make up the current graph.
@@ -26,6 +26,20 @@ class ReadFromGraph : public DirectedSubgraph
   TopologicalOrderedActions const& m_topological_ordered_actions;    // Maps node sequence numbers to Action objects.
   std::vector<RFLocation> m_location_id_to_rf_location;         // Maps location tags to an index into m_current_subgraphs.
 
+  // The state of a node that is being followed by dfs().
+  struct Frame
+  {
+    SequenceNumber m_node;                      // The node.
+    Action* m_action;                           // The Action of m_node.
+    RFLocation m_location;                      // The index into m_current_subgraphs of the memory location of m_action (if any).
+    bool m_have_location_subgraph;              // Set if m_location refers to a subgraph in m_current_subgraphs.
+    bool m_is_write;                            // Set if m_action is a write to the memory location of that subgraph.
+    int m_opsem_or_rf;                          // 0: m_edge is an opsem edge, 1: m_edge is an rf edge.
+    DirectedEdgeIterator m_edge;                // The next outgoing edge of m_node to follow.
+    DirectedEdgeIterator m_end;                 // The end of the outgoing edges of m_node in the current subgraph.
+  };
+  std::vector<Frame> m_stack;                                   // The nodes that are currently being followed (reused by every dfs()).
+
  public:
   // Reset all nodes to the state 'unvisited'.
   void reset() { m_generation += 3; }
@@ -55,12 +69,15 @@ class ReadFromGraph : public DirectedSubgraph
   bool is_processed(SequenceNumber n) const { return m_node_data[n].m_set == m_generation + 3; }
 
   // Constructor.
+  // The subgraphs of the memory locations `locations' (indices into read_from_location_subgraphs_vector) must be pushed in that order.
+  // The rf edges of all other locations are never followed.
   ReadFromGraph(
       Graph const& graph,
       EdgeMaskType outgoing_type,
       EdgeMaskType incoming_type,
       TopologicalOrderedActions const& topological_ordered_actions,
-      std::vector<ReadFromLocationSubgraphs> const& read_from_location_subgraphs_vector);
+      std::vector<ReadFromLocationSubgraphs> const& read_from_location_subgraphs_vector,
+      std::vector<RFLocation> const& locations);
 
   void push(DirectedSubgraph const& directed_subgraph) { m_current_subgraphs.push_back(&directed_subgraph); }
   void pop() { m_current_subgraphs.pop_back(); }
@@ -74,12 +91,15 @@ class ReadFromGraph : public DirectedSubgraph
   // Do a Depth-First-Search starting from node m_current_node, returning true if and only if we detected
   // at least one Property, in which case m_loop_condition is set to the (possibly zero) condition under
   // which an inconsistency was found (if any).
-  // If current_memory_location is unequal zero than it is the memory location that the current node reads
-  // from or writes to.
   bool dfs();
 
   // Return the current node in the Depth-First-Search (only valid while inside dfs()).
   SequenceNumber current_node() const { return m_current_node; }
+
+ private:
+  void begin_node();
+  void follow_edge(Frame const& frame);
+  bool end_node();
 };
 
 #ifdef CWDEBUG
@@ -1,7 +1,83 @@
 #include "sys.h"
 #include "ReadFromLocationSubgraphs.h"
+#include "Action.h"
+#include "debug.h"
 
-void ReadFromLocationSubgraphs::add(DirectedSubgraph&& read_from_subgraph)
+void ReadFromLocationSubgraphs::add_write_action(Action const* write_action)
 {
+  if (write_action->exists().is_one())
+    m_writes.push_back(write_action);
+}
+
+bool ReadFromLocationSubgraphs::add(DirectedSubgraph&& read_from_subgraph)
+{
+  if (!is_coherent(read_from_subgraph))
+  {
+    ++m_incoherent;
+    return false;
+  }
   m_subgraphs.emplace_back(std::move(read_from_subgraph));
+  return true;
+}
+
+namespace {
+
+// Return true if directed_edge, and both actions that it connects, exist unconditionally.
+bool is_unconditional(DirectedEdge const& directed_edge)
+{
+  return directed_edge.condition().is_one() && directed_edge.tail_node()->exists().is_one() && directed_edge.head_node()->exists().is_one();
+}
+
+} // namespace
+
+// All rf edges of a subgraph belong to the same location, so the coherence rules of
+// that location can be checked locally, using only the sequenced-before relation
+// (a subset of happens-before) and without a modification order:
+//
+// - A read may not read from a write that it is sequenced before (CoRW).
+// - A read may not read from a write that is hidden by another write that is
+//   sequenced between them (CoWR).
+// - If r1 is sequenced before r2, and they read from different writes w1 and w2,
+//   then w2 may not be sequenced before w1 or r1 (CoRR).
+//
+// CoWW, and every coherence violation that needs it (like two readers on different
+// threads that observe two writes in opposite order), is NOT checked: that requires
+// a modification order of the writes, and the analysis does not construct one.
+//
+// Only rf edges that exist unconditionally are considered: a violation that only exists
+// under some condition is left to the loop detection.
+//
+bool ReadFromLocationSubgraphs::is_coherent(DirectedSubgraph const& read_from_subgraph) const
+{
+  for (DirectedEdge const& rf1 : read_from_subgraph)
+  {
+    if (!is_unconditional(rf1))
+      continue;
+    Action const& w1{*rf1.tail_node()};
+    Action const& r1{*rf1.head_node()};
+    if (r1.is_sequenced_before(w1))
+    {
+      Dout(dc::notice, "Rejecting rf subgraph: " << r1.name() << " reads from " << w1.name() << " which it is sequenced before.");
+      return false;
+    }
+    for (Action const* write : m_writes)
+      if (w1.is_sequenced_before(*write) && write->is_sequenced_before(r1))
+      {
+        Dout(dc::notice, "Rejecting rf subgraph: " << r1.name() << " reads from " << w1.name() << " which is hidden by " << write->name() << '.');
+        return false;
+      }
+    for (DirectedEdge const& rf2 : read_from_subgraph)
+    {
+      Action const& w2{*rf2.tail_node()};
+      Action const& r2{*rf2.head_node()};
+      if (w2 == w1 || !r1.is_sequenced_before(r2) || !is_unconditional(rf2))
+        continue;
+      if (w2.is_sequenced_before(w1) || w2.is_sequenced_before(r1))
+      {
+        Dout(dc::notice, "Rejecting rf subgraph: " << r1.name() << " reads from " << w1.name() << " but the later " << r2.name() << " reads from the older " << w2.name() << '.');
+        return false;
+      }
+    }
+  }
+  return true;
 }
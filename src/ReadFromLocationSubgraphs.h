@@ -5,6 +5,7 @@
 #include <vector>
 
 class Location;
+class Action;
 
 class ReadFromLocationSubgraphs
 {
@@ -14,16 +15,23 @@ class ReadFromLocationSubgraphs
   using const_iterator = subgraphs_type::const_iterator;
 
  private:
-  Location const& m_location;   // The memory location that this object contains Read-From edge subgraphs for.
-  subgraphs_type m_subgraphs;   // Possible Read-From edge subgraphs for this location.
+  Location const& m_location;           // The memory location that this object contains Read-From edge subgraphs for.
+  subgraphs_type m_subgraphs;           // Possible Read-From edge subgraphs for this location.
+  std::vector<Action const*> m_writes;  // The write actions to this location that exist unconditionally.
+  size_t m_incoherent;                  // The number of subgraphs that add() rejected.
 
  public:
-  ReadFromLocationSubgraphs(Location const& location) : m_location(location) { }
+  ReadFromLocationSubgraphs(Location const& location) : m_location(location), m_incoherent(0) { }
 
-  void add(DirectedSubgraph&& read_from_subgraph);
+  // Register a write action to this location. Call this for all writes before calling add.
+  void add_write_action(Action const* write_action);
+
+  // Add read_from_subgraph, unless it violates coherence; return false if it was rejected.
+  bool add(DirectedSubgraph&& read_from_subgraph);
 
   // Accessor.
   size_t size() const { return m_subgraphs.size(); }
+  size_t incoherent() const { return m_incoherent; }
   Location const& location() const { return m_location; }
   DirectedSubgraph const& operator[](int index) const { return m_subgraphs[index]; }
 
@@ -31,4 +39,7 @@ class ReadFromLocationSubgraphs
   const_iterator begin() const { return m_subgraphs.begin(); }
   iterator end() { return m_subgraphs.end(); }
   const_iterator end() const { return m_subgraphs.end(); }
+
+ private:
+  bool is_coherent(DirectedSubgraph const& read_from_subgraph) const;
 };
@@ -48,12 +48,14 @@ bool ReadFromLoop::store_write(Action* write_action, boolean::Expression&& condi
 
 namespace {
 
-bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expression const& condition, int visited_generation);
+// Both functions add every action whose Read-From edges they follow to depends_on.
+bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expression const& condition, VisitedEdges& visited_edges, int visited_generation, ActionSet& depends_on);
 
-bool can_be_reached_from_rfs_of(Action* begin_action, Action* end_action, Action* origin_action, boolean::Expression const& condition, int visited_generation)
+bool can_be_reached_from_rfs_of(Action* begin_action, Action* end_action, Action* origin_action, boolean::Expression const& condition, VisitedEdges& visited_edges, int visited_generation, ActionSet& depends_on)
 {
   DoutEntering(dc::notice, "can_be_reached_from_rfs_of(from:" << begin_action->name() <<
       ", to:" << end_action->name() << ", origin:" << origin_action->name() << ", condition:" << condition << ", " << visited_generation << ")");
+  depends_on.add(*begin_action);
   for (auto&& end_point : begin_action->get_end_points())
   {
     Action* other_node{end_point.other_node()};
@@ -65,14 +67,14 @@ bool can_be_reached_from_rfs_of(Action* begin_action, Action* end_action, Action
     ASSERT(!(*other_node == *origin_action));
     boolean::Expression accumulative_path_condition{condition.times(end_point.edge()->exists())};
     if (!accumulative_path_condition.is_zero() &&
-        (can_be_reached_from_rfs_of(other_node, end_action, begin_action, accumulative_path_condition, visited_generation) ||
-         can_be_reached_from(other_node, end_action, accumulative_path_condition, visited_generation)))
+        (can_be_reached_from_rfs_of(other_node, end_action, begin_action, accumulative_path_condition, visited_edges, visited_generation, depends_on) ||
+         can_be_reached_from(other_node, end_action, accumulative_path_condition, visited_edges, visited_generation, depends_on)))
       return true;
   }
   return false;
 }
 
-bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expression const& condition, int visited_generation)
+bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expression const& condition, VisitedEdges& visited_edges, int visited_generation, ActionSet& depends_on)
 {
   DoutEntering(dc::notice, "can_be_reached_from(" << *begin_action << ", " << *end_action << ", " << condition << ", " << visited_generation << ")");
   struct can_be_reached_from_data
@@ -80,12 +82,14 @@ bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expr
     bool reached_end;
     Action* end_action;
     boolean::Expression condition;
+    VisitedEdges& visited_edges;
     int visited_generation;
-    can_be_reached_from_data(Action* end_action_, boolean::Expression const& condition_, int visited_generation_) :
-        reached_end(false), end_action(end_action_), condition(condition_.copy()), visited_generation(visited_generation_) { }
+    ActionSet& depends_on;
+    can_be_reached_from_data(Action* end_action_, boolean::Expression const& condition_, VisitedEdges& visited_edges_, int visited_generation_, ActionSet& depends_on_) :
+        reached_end(false), end_action(end_action_), condition(condition_.copy()), visited_edges(visited_edges_), visited_generation(visited_generation_), depends_on(depends_on_) { }
   };
-  can_be_reached_from_data data(end_action, condition, visited_generation);
-  FollowVisitedOpsemHeads follow_visited_opsem_heads(begin_action, visited_generation);
+  can_be_reached_from_data data(end_action, condition, visited_edges, visited_generation, depends_on);
+  FollowVisitedOpsemHeads follow_visited_opsem_heads(begin_action, visited_edges, visited_generation);
   follow_visited_opsem_heads.process_queued(
       [&data](Action* action, boolean::Expression&& path_condition)  // if_found
       {
@@ -95,7 +99,7 @@ bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expr
         {
           boolean::Expression accumulative_path_condition{data.condition * path_condition.as_product()};
           data.reached_end = !accumulative_path_condition.is_zero() &&
-            can_be_reached_from_rfs_of(action, data.end_action, action, accumulative_path_condition, data.visited_generation);
+            can_be_reached_from_rfs_of(action, data.end_action, action, accumulative_path_condition, data.visited_edges, data.visited_generation, data.depends_on);
         }
         return data.reached_end;     // Stop following edges when we find the end point.
       }
@@ -105,13 +109,63 @@ bool can_be_reached_from(Action* begin_action, Action* end_action, boolean::Expr
 
 } // namespace
 
-bool ReadFromLoop::find_next_write_action(ReadFromLoopsPerLocation& read_from_loops_per_location, int& visited_generation)
+ActionSet ReadFromLoop::rf_actions() const
+{
+  ActionSet rf_actions;
+  rf_actions.add(*m_read_action);
+  for (auto&& write_action_condition_pair : m_write_actions)
+    rf_actions.add(*write_action_condition_pair.first);
+  return rf_actions;
+}
+
+void ReadFromLoop::delete_edge(ReadFromLoopsPerLocation& read_from_loops_per_location)
+{
+  if (m_write_actions.empty())
+    return;
+  read_from_loops_per_location.invalidate_reachability(m_read_action, rf_actions());
+  for (auto&& write_action_condition_pair : m_write_actions)
+    write_action_condition_pair.first->delete_edge_to(edge_rf, m_read_action);
+  m_write_actions.clear();
+}
+
+bool ReadFromLoop::add_edge(ReadFromLoopsPerLocation& read_from_loops_per_location)
+{
+  // This function can add more than one edge: edges that are
+  // mutual exclusive depending on which branches are taken.
+  // Set m_have_write to the boolean expression under which
+  // we have a Read-From edge.
+  m_have_write = false;
+  bool new_edges = false;
+  for (auto&& write_action_condition_pair : m_write_actions)
+  {
+    new_edges = true;
+    write_action_condition_pair.first->add_edge_to(edge_rf, m_read_action, write_action_condition_pair.second.copy());
+    m_have_write += write_action_condition_pair.second * write_action_condition_pair.first->exists().as_product();
+  }
+  Dout(dc::notice, "Setting \"" << m_read_action->name() << "\"::m_have_write set to " << m_have_write << '.');
+  if (new_edges)
+    read_from_loops_per_location.invalidate_reachability(m_read_action, rf_actions());
+  return new_edges;
+}
+
+void ReadFromLoop::invalidate_reachability(ActionSet const& changed_actions)
+{
+  for (auto iter = m_reachability_cache.begin(); iter != m_reachability_cache.end();)
+  {
+    if (iter->second.m_depends_on.intersects(changed_actions))
+      iter = m_reachability_cache.erase(iter);
+    else
+      ++iter;
+  }
+}
+
+bool ReadFromLoop::find_next_write_action(ReadFromLoopsPerLocation& read_from_loops_per_location, VisitedEdges& visited_edges)
 {
 #ifdef CWDEBUG
   DoutEntering(dc::notice, "find_next_write_action() on ReadFromLoop for read action " << *m_read_action);
   debug::Mark marker{m_read_action->name().c_str()};
 #endif
-  // g++ starts allocating memory for lambda's capturing more than 16 bytes (clang++ 24 bytes), so put all data that we need in a struct.
+  // Put all data that we need in a struct, so that the lambdas below only capture `this' and a reference to it.
   struct ReadFromIfFoundData
   {
     boolean::Expression found_write;    // Boolean expression under which we found a write.
@@ -131,7 +185,7 @@ bool ReadFromLoop::find_next_write_action(ReadFromLoopsPerLocation& read_from_lo
     Dout(dc::notice, "m_first_iteration is true.");
     ASSERT(m_queued_actions.empty());
     // Look for the last write (if any) on the same thread.
-    FollowVisitedOpsemHeads follow_visited_opsem_heads(m_read_action, ++visited_generation);
+    FollowVisitedOpsemHeads follow_visited_opsem_heads(m_read_action, visited_edges, visited_edges.next_generation());
     follow_visited_opsem_heads.process_queued(
         [this, &data](Action* action, boolean::Expression&& path_condition)  // if_found
         {
@@ -210,10 +264,22 @@ bool ReadFromLoop::find_next_write_action(ReadFromLoopsPerLocation& read_from_lo
         {
           Dout(dc::notice|continued_cf, "Found unsequenced write " << **m_topo_next);
           boolean::Expression condition{new_rf_exists};
-          if (!can_be_reached_from_rfs_of(m_read_action, *m_topo_next, m_read_action, condition, ++visited_generation) &&
-              !can_be_reached_from(m_read_action, *m_topo_next, condition, ++visited_generation) &&
-              !can_be_reached_from_rfs_of(*m_topo_next, m_read_action, *m_topo_next, condition, ++visited_generation) &&
-              !can_be_reached_from(*m_topo_next, m_read_action, condition, ++visited_generation))
+          // Only the Read-From edges of the previous loops are present, and the
+          // result only changes when any of the edges that were followed changes.
+          auto cached = m_reachability_cache.find(*m_topo_next);
+          if (cached == m_reachability_cache.end())
+          {
+            Reachability reachability{false, {}};
+            reachability.m_reachable =
+                can_be_reached_from_rfs_of(m_read_action, *m_topo_next, m_read_action, condition, visited_edges, visited_edges.next_generation(), reachability.m_depends_on) ||
+                can_be_reached_from(m_read_action, *m_topo_next, condition, visited_edges, visited_edges.next_generation(), reachability.m_depends_on) ||
+                can_be_reached_from_rfs_of(*m_topo_next, m_read_action, *m_topo_next, condition, visited_edges, visited_edges.next_generation(), reachability.m_depends_on) ||
+                can_be_reached_from(*m_topo_next, m_read_action, condition, visited_edges, visited_edges.next_generation(), reachability.m_depends_on);
+            cached = m_reachability_cache.emplace(*m_topo_next, reachability).first;
+          }
+          else
+            Dout(dc::continued, " (reachability cached)");
+          if (!cached->second.m_reachable)
           {
             store_write(*m_topo_next, std::move(condition), data.found_write, true);
             data.at_end_of_loop = false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Action.h"
+#include "ActionSet.h"
 #include "debug.h"
 #include "TopologicalOrderedActions.h"
 #include "boolean-expression/BooleanExpression.h"
@@ -9,12 +10,21 @@
 #include <vector>
 
 class ReadFromLoopsPerLocation;
+class VisitedEdges;
 
 class ReadFromLoop
 {
   using write_actions_type = std::map<Action*, boolean::Expression>;
   using queued_actions_type = std::deque<std::pair<Action*, boolean::Expression>>;
 
+  // The cached result of the test whether m_read_action and an unsequenced write can reach each other (see find_next_write_action).
+  struct Reachability
+  {
+    bool m_reachable;                           // Set if there is a path between the read and the write, in either direction.
+    ActionSet m_depends_on;                     // The actions whose Read-From edges were followed (or could have been) to find m_reachable.
+  };
+  using reachability_cache_type = std::map<Action*, Reachability>;
+
  private:
   Action* m_read_action;                        // The read action that we're looping over all possible write actions that it Read-Froms.
   bool m_first_iteration;                       // Set to true upon the first iteration of this loop.
@@ -25,6 +35,7 @@ class ReadFromLoop
   TopologicalOrderedActions::const_iterator m_topo_begin;
   TopologicalOrderedActions::const_iterator m_topo_next;
   TopologicalOrderedActions::const_iterator m_topo_end;
+  reachability_cache_type m_reachability_cache; // Cached reachability of unsequenced writes, valid for the current Read-From edges of the previous loops.
 
  public:
   ReadFromLoop(Action* read_action, TopologicalOrderedActions::const_iterator const& topo_begin, TopologicalOrderedActions::const_iterator const& topo_end) :
@@ -35,7 +46,8 @@ class ReadFromLoop
     m_write_actions(std::move(read_from_loop.m_write_actions)),
     m_queued_actions(std::move(read_from_loop.m_queued_actions)),
     m_topo_begin(std::move(read_from_loop.m_topo_begin)),
-    m_topo_end(std::move(read_from_loop.m_topo_end)) { }
+    m_topo_end(std::move(read_from_loop.m_topo_end)),
+    m_reachability_cache(std::move(read_from_loop.m_reachability_cache)) { }
 
   boolean::Expression const& have_write() const { return m_have_write; }
   boolean::Expression const& have_read() const { return m_read_action->exists(); }
@@ -48,34 +60,21 @@ class ReadFromLoop
     m_topo_next = m_topo_begin;
   }
 
-  bool find_next_write_action(ReadFromLoopsPerLocation& read_from_loops_per_location, int& visited_generation);
+  bool find_next_write_action(ReadFromLoopsPerLocation& read_from_loops_per_location, VisitedEdges& visited_edges);
 
-  void delete_edge()
-  {
-    // Delete any edges that were added in the last call to add_edge (if any).
-    for (auto&& write_action_condition_pair : m_write_actions)
-      write_action_condition_pair.first->delete_edge_to(edge_rf, m_read_action);
-    m_write_actions.clear();
-  }
+  // Delete any edges that were added in the last call to add_edge (if any).
+  void delete_edge(ReadFromLoopsPerLocation& read_from_loops_per_location);
 
-  bool add_edge()
-  {
-    // This function can add more than one edge: edges that are
-    // mutual exclusive depending on which branches are taken.
-    // Set m_have_write to the boolean expression under which
-    // we have a Read-From edge.
-    m_have_write = false;
-    bool new_edges = false;
-    for (auto&& write_action_condition_pair : m_write_actions)
-    {
-      new_edges = true;
-      write_action_condition_pair.first->add_edge_to(edge_rf, m_read_action, write_action_condition_pair.second.copy());
-      m_have_write += write_action_condition_pair.second * write_action_condition_pair.first->exists().as_product();
-    }
-    Dout(dc::notice, "Setting \"" << m_read_action->name() << "\"::m_have_write set to " << m_have_write << '.');
-    return new_edges;
-  }
+  // Add the Read-From edges from all write actions that were found by find_next_write_action.
+  // Returns true if any edge was added.
+  bool add_edge(ReadFromLoopsPerLocation& read_from_loops_per_location);
+
+  // Forget the cached reachability of every write that depends on the Read-From edges of any of the actions in changed_actions.
+  void invalidate_reachability(ActionSet const& changed_actions);
 
  private:
+  // Return the set of m_read_action and all write actions in m_write_actions.
+  ActionSet rf_actions() const;
+
   bool store_write(Action* write_action, boolean::Expression&& condition, boolean::Expression& found_write, bool queue);
 };
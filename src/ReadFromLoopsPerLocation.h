@@ -29,6 +29,14 @@ class ReadFromLoopsPerLocation
     return m_read_from_loops[read_action->get_read_from_loop_index()];
   }
 
+  // Called when the Read-From edges of the read action read_action, from or to any of the actions in changed_actions, changed.
+  // The reachability cached by the later loops might depend on those edges.
+  void invalidate_reachability(Action* read_action, ActionSet const& changed_actions)
+  {
+    for (size_t index = read_action->get_read_from_loop_index() + 1; index < m_read_from_loops.size(); ++index)
+      m_read_from_loops[index].invalidate_reachability(changed_actions);
+  }
+
   size_t number_of_read_actions() const { return m_read_from_loops.size(); }
 
   // Called when at the top of loop read_from_loop_index. Returns true when this loop was just entered.
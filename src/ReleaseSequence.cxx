@@ -1,7 +1,17 @@
 #include "sys.h"
 #include "ReleaseSequence.h"
+#include "Context.h"
+#include "BooleanVariables.h"
 #include <ostream>
 
+ReleaseSequence::ReleaseSequence(SequenceNumber begin, SequenceNumber end) :
+    m_begin(begin), m_end(end),
+    m_id(Context::instance().next_release_sequence_id()),
+    m_boolexpr_variable(BooleanVariables::get(BooleanVariables::release_sequence, m_id))
+{
+  Dout(dc::notice, "Created a new ReleaseSequence(" << begin << ", " << end << "), id " << m_id << ", with m_boolexpr_variable " << m_boolexpr_variable);
+}
+
 std::string ReleaseSequence::id_name() const
 {
   return std::string(1, 'A' + m_id);
@@ -12,6 +22,3 @@ std::ostream& operator<<(std::ostream& os, ReleaseSequence const& release_sequen
   os << "{" << release_sequence.m_begin << "-rs:" << release_sequence.m_boolexpr_variable << "->" << release_sequence.m_end << " [" << release_sequence.m_id << "]}";
   return os;
 }
-
-//static
-ReleaseSequence::id_type ReleaseSequence::s_next_release_sequence_id;
@@ -16,17 +16,11 @@ struct ReleaseSequence
   SequenceNumber m_begin;       // The node where the release sequence begins.
   SequenceNumber m_end;         // The node where the release sequence ends.
 
-  id_type m_id;
+  id_type m_id;                                 // The first ReleaseSequence object of a test has id 0.
   boolean::Variable m_boolexpr_variable;
-  static id_type s_next_release_sequence_id;    // The id to use for the next ReleaseSequence.
-                                                // The first ReleaseSequence object has id 0.
 
   // Construct a new id / boolean variable pair.
-  ReleaseSequence(SequenceNumber begin, SequenceNumber end) :
-      m_begin(begin), m_end(end),
-      m_id(s_next_release_sequence_id++),
-      m_boolexpr_variable(boolean::Context::instance().create_variable(id_name()))
-    { Dout(dc::notice, "Created a new ReleaseSequence(" << begin << ", " << end << "), id " << m_id << ", with m_boolexpr_variable " << m_boolexpr_variable); }
+  ReleaseSequence(SequenceNumber begin, SequenceNumber end);
 
   id_type id() const { return m_id; }
   std::string id_name() const;
@@ -0,0 +1,79 @@
+#include "sys.h"
+#include "ResultCache.h"
+#include "cppmem_analyzer.h"
+#include "NDJSONWriter.h"
+#include "debug.h"
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+// Increment this when the cached results change (for example, because the analysis was changed).
+constexpr int results_version = 4;
+
+} // namespace
+
+ResultCache::ResultCache(std::string const& directory) : m_directory(directory)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  if (ec)
+    Dout(dc::warning, "Failed to create cache directory \"" << m_directory << "\": " << ec.message());
+}
+
+//static
+char const* ResultCache::tool_version()
+{
+  static std::string const version = std::string(
+#ifdef PACKAGE_VERSION
+      PACKAGE_VERSION
+#else
+      "0"
+#endif
+      ) + "." + std::to_string(results_version);
+  return version.c_str();
+}
+
+bool ResultCache::lookup(std::string const& ast_hash, Entry& entry) const
+{
+  std::ifstream file(filepath(ast_hash));
+  if (!file)
+    return false;
+  std::string magic, version;
+  if (!(file >> magic >> version) || magic != "cppmem-cache" || version != tool_version())
+    return false;
+  if (!(file >> entry.candidates >> entry.distinct_graphs >> entry.unsequenced_races))
+    return false;
+  file >> std::ws;
+  return static_cast<bool>(std::getline(file, entry.record));
+}
+
+void ResultCache::store(std::string const& ast_hash, cppmem::Result const& result) const
+{
+  // Write to a temporary file first, so that a concurrent lookup never sees a partial entry.
+  // Every writer (of any process or thread) uses its own temporary file.
+  static std::atomic<unsigned int> s_temporary_files;
+  std::string const path = filepath(ast_hash);
+  std::string const temporary_path = path + '.' + std::to_string(getpid()) + '.' + std::to_string(s_temporary_files++) + ".tmp";
+  {
+    std::ofstream file(temporary_path);
+    file << "cppmem-cache " << tool_version() << '\n' <<
+      result.statistics.candidates << ' ' << result.statistics.distinct_graphs << ' ' << result.unsequenced_races.size() << '\n';
+    NDJSONWriter ndjson_writer(file);
+    ndjson_writer.write_result(result);
+    if (!file.flush())
+    {
+      Dout(dc::warning, "Failed to write \"" << temporary_path << "\".");
+      std::remove(temporary_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+  {
+    Dout(dc::warning, "Failed to rename \"" << temporary_path << "\" to \"" << path << "\".");
+    std::remove(temporary_path.c_str());
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+namespace cppmem {
+struct Result;
+} // namespace cppmem
+
+// An on-disk cache of analysis results, keyed on the normalized AST hash (see cppmem::normalized_ast_hash).
+//
+// Every result is stored in its own file, named after the hash, in the
+// cache directory:
+//
+//   cppmem-cache <tool version>
+//   <candidates> <distinct graphs> <unsequenced races>
+//   <the NDJSON record of the result (see NDJSONWriter::write_result)>
+//
+// Entries that were written by a different tool version are ignored (and overwritten).
+//
+class ResultCache
+{
+ public:
+  struct Entry
+  {
+    int candidates;                     // The number of consistent rf candidates.
+    int distinct_graphs;                // The number of distinct graphs among those candidates.
+    int unsequenced_races;              // The number of unsequenced races.
+    std::string record;                 // The NDJSON record (without the trailing newline).
+  };
+
+ private:
+  std::string m_directory;
+
+ public:
+  // Use (and create, if necessary) the cache directory `directory'.
+  ResultCache(std::string const& directory);
+
+  // Look up the result with hash ast_hash. Returns true and fills entry if it is cached.
+  bool lookup(std::string const& ast_hash, Entry& entry) const;
+
+  // Store the (successful) result with hash ast_hash.
+  void store(std::string const& ast_hash, cppmem::Result const& result) const;
+
+  // The version of the analysis that wrote the cached results.
+  static char const* tool_version();
+
+ private:
+  std::string filepath(std::string const& ast_hash) const { return m_directory + '/' + ast_hash; }
+};
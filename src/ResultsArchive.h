@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+// The layout of a results archive file.
+//
+// A results archive contains everything that is needed to render any
+// of the rf candidates of one test to dot, without the need to run
+// the analysis again. It is written sequentially (see ResultsArchiveWriter)
+// and meant to be mmap-ed for random access (see ResultsArchiveReader).
+//
+// All integers are stored in native byte order.
+//
+//   Header
+//   dot prefix                 The frozen opsem graph: header, nodes and non-witness edges (see Graph::cache_dot_prefix).
+//   legend rows                The rows of the legend for the conditionals and release sequences.
+//   subgraph edges...          For every rf subgraph of every location, its edges in dot format.
+//   CandidateRecord...         One fixed-width record per candidate, in the order that they were found.
+//   valid strings...           The (html) valid expression of every subgraph and candidate.
+//   SubgraphEntry...           One entry per rf subgraph, ordered by location.
+//   uint32_t...                Per location the index of its first SubgraphEntry, plus one for the end.
+//   Footer
+//
+namespace results_archive {
+
+static constexpr char magic[8] = { 'C', 'P', 'P', 'M', 'E', 'M', 'R', 'A' };
+static constexpr uint32_t version = 1;
+
+struct Header
+{
+  char m_magic[8];
+  uint32_t m_version;
+  uint32_t m_reserved;
+};
+
+struct Footer
+{
+  uint64_t m_dot_prefix_offset;
+  uint64_t m_dot_prefix_size;
+  uint64_t m_legend_rows_offset;
+  uint64_t m_legend_rows_size;
+  uint64_t m_candidates_offset;         // Offset of the first CandidateRecord.
+  uint64_t m_number_of_candidates;
+  uint64_t m_record_size;               // The size of one CandidateRecord, including its subgraph indices.
+  uint64_t m_strings_offset;            // Offset of the valid strings; string offsets are relative to this.
+  uint64_t m_subgraphs_offset;          // Offset of the first SubgraphEntry.
+  uint64_t m_number_of_subgraphs;
+  uint64_t m_locations_offset;          // Offset of the location table.
+  uint64_t m_number_of_locations;
+  char m_magic[8];
+};
+
+struct SubgraphEntry
+{
+  uint64_t m_edges_offset;              // Offset of the edges of this subgraph in dot format.
+  uint32_t m_edges_size;
+  uint32_t m_valid_offset;              // Offset of the html valid string of this subgraph, relative to Footer::m_strings_offset.
+  uint32_t m_valid_size;
+  uint32_t m_reserved;
+};
+
+enum candidate_flags : uint32_t
+{
+  candidate_duplicate = 1,              // This candidate is the same graph as an earlier candidate.
+  candidate_unsequenced_races = 2,      // The graph contains unsequenced races.
+  candidate_loop = 4                    // The candidate contains a loop under some condition.
+};
+
+// This is followed by m_number_of_locations uint32_t's: the index of the rf subgraph of each location (relative to that location).
+struct CandidateRecord
+{
+  uint32_t m_candidate;                 // The candidate number.
+  uint32_t m_flags;                     // A bit mask of candidate_flags.
+  uint32_t m_valid_offset;              // Offset of the html valid string of this candidate, relative to Footer::m_strings_offset.
+  uint32_t m_valid_size;
+};
+
+} // namespace results_archive
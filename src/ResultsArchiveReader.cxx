@@ -0,0 +1,158 @@
+#include "sys.h"
+#include "ResultsArchiveReader.h"
+#include "Graph.h"
+#include "utils/AIAlert.h"
+#include "debug.h"
+#include <ostream>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+ResultsArchiveReader::ResultsArchiveReader(std::string const& filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    THROW_ALERT("Failed to open results archive \"[FILENAME]\"", AIArgs("[FILENAME]", filename));
+  struct stat st;
+  if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(results_archive::Header) + sizeof(results_archive::Footer))
+  {
+    close(fd);
+    THROW_ALERT("\"[FILENAME]\" is not a results archive", AIArgs("[FILENAME]", filename));
+  }
+  m_size = st.st_size;
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    THROW_ALERT("Failed to mmap results archive \"[FILENAME]\"", AIArgs("[FILENAME]", filename));
+  m_data = static_cast<char const*>(data);
+
+  results_archive::Header const* header = reinterpret_cast<results_archive::Header const*>(m_data);
+  m_footer = reinterpret_cast<results_archive::Footer const*>(m_data + m_size - sizeof(results_archive::Footer));
+  if (std::memcmp(header->m_magic, results_archive::magic, sizeof(header->m_magic)) != 0 ||
+      std::memcmp(m_footer->m_magic, results_archive::magic, sizeof(m_footer->m_magic)) != 0 ||
+      header->m_version != results_archive::version)
+  {
+    munmap(data, m_size);
+    THROW_ALERT("\"[FILENAME]\" is not a (version [VERSION]) results archive", AIArgs("[FILENAME]", filename)("[VERSION]", results_archive::version));
+  }
+  m_subgraphs = reinterpret_cast<results_archive::SubgraphEntry const*>(m_data + m_footer->m_subgraphs_offset);
+  m_locations = reinterpret_cast<uint32_t const*>(m_data + m_footer->m_locations_offset);
+  if (!is_consistent())
+  {
+    munmap(data, m_size);
+    THROW_ALERT("\"[FILENAME]\" is a corrupt results archive", AIArgs("[FILENAME]", filename));
+  }
+}
+
+bool ResultsArchiveReader::in_strings(uint64_t offset, uint64_t size) const
+{
+  // The strings are followed by the (aligned) subgraph table.
+  uint64_t const strings_size = m_footer->m_subgraphs_offset - m_footer->m_strings_offset;
+  return offset <= strings_size && size <= strings_size - offset;
+}
+
+bool ResultsArchiveReader::is_consistent() const
+{
+  using namespace results_archive;
+  uint64_t const end_of_data = m_size - sizeof(Footer);         // Everything but the footer.
+  Footer const& footer{*m_footer};
+
+  // The sections, in the order that they were written (see ResultsArchive.h).
+  if (end_of_data % alignof(Footer) != 0 ||
+      footer.m_dot_prefix_offset < sizeof(Header) ||
+      !in_file(footer.m_dot_prefix_offset, footer.m_dot_prefix_size) ||
+      !in_file(footer.m_legend_rows_offset, footer.m_legend_rows_size) ||
+      footer.m_candidates_offset % alignof(CandidateRecord) != 0 ||
+      footer.m_candidates_offset > footer.m_strings_offset ||
+      footer.m_strings_offset > footer.m_subgraphs_offset ||
+      footer.m_subgraphs_offset % alignof(SubgraphEntry) != 0 ||
+      footer.m_subgraphs_offset > end_of_data ||
+      footer.m_number_of_subgraphs > (end_of_data - footer.m_subgraphs_offset) / sizeof(SubgraphEntry) ||
+      footer.m_locations_offset != footer.m_subgraphs_offset + footer.m_number_of_subgraphs * sizeof(SubgraphEntry) ||
+      footer.m_number_of_locations >= (end_of_data - footer.m_locations_offset) / sizeof(uint32_t))
+    return false;
+
+  // The candidate records must exactly fill the space up till the strings.
+  if (footer.m_record_size != sizeof(CandidateRecord) + footer.m_number_of_locations * sizeof(uint32_t) ||
+      footer.m_number_of_candidates != (footer.m_strings_offset - footer.m_candidates_offset) / footer.m_record_size ||
+      (footer.m_strings_offset - footer.m_candidates_offset) % footer.m_record_size != 0)
+    return false;
+
+  // The location table holds, per location, the index of its first subgraph, plus one for the end.
+  if (m_locations[0] != 0 || m_locations[footer.m_number_of_locations] != footer.m_number_of_subgraphs)
+    return false;
+  for (size_t location = 0; location < footer.m_number_of_locations; ++location)
+    if (m_locations[location] > m_locations[location + 1])
+      return false;
+
+  for (size_t subgraph = 0; subgraph < footer.m_number_of_subgraphs; ++subgraph)
+  {
+    SubgraphEntry const& entry{m_subgraphs[subgraph]};
+    if (!in_file(entry.m_edges_offset, entry.m_edges_size) || !in_strings(entry.m_valid_offset, entry.m_valid_size))
+      return false;
+  }
+
+  for (size_t index = 0; index < footer.m_number_of_candidates; ++index)
+  {
+    if (!in_strings(record(index).m_valid_offset, record(index).m_valid_size))
+      return false;
+    for (size_t location = 0; location < footer.m_number_of_locations; ++location)
+      if (subgraph_index(index, location) >= m_locations[location + 1] - m_locations[location])
+        return false;
+  }
+  return true;
+}
+
+ResultsArchiveReader::~ResultsArchiveReader()
+{
+  munmap(const_cast<char*>(m_data), m_size);
+}
+
+results_archive::CandidateRecord const& ResultsArchiveReader::record(size_t index) const
+{
+  ASSERT(index < m_footer->m_number_of_candidates);
+  return *reinterpret_cast<results_archive::CandidateRecord const*>(m_data + m_footer->m_candidates_offset + index * m_footer->m_record_size);
+}
+
+uint32_t ResultsArchiveReader::subgraph_index(size_t index, size_t location) const
+{
+  ASSERT(location < m_footer->m_number_of_locations);
+  uint32_t const* subgraph_indices = reinterpret_cast<uint32_t const*>(&record(index) + 1);
+  return subgraph_indices[location];
+}
+
+size_t ResultsArchiveReader::number_of_subgraphs(size_t location) const
+{
+  ASSERT(location < m_footer->m_number_of_locations);
+  return m_locations[location + 1] - m_locations[location];
+}
+
+std::string ResultsArchiveReader::subgraph_valid(size_t location, size_t subgraph) const
+{
+  ASSERT(subgraph < number_of_subgraphs(location));
+  results_archive::SubgraphEntry const& entry{m_subgraphs[m_locations[location] + subgraph]};
+  return string(m_footer->m_strings_offset + entry.m_valid_offset, entry.m_valid_size);
+}
+
+std::string ResultsArchiveReader::string(uint64_t offset, uint64_t size) const
+{
+  return std::string(m_data + offset, size);
+}
+
+void ResultsArchiveReader::write_dot(std::ostream& out, size_t index) const
+{
+  results_archive::CandidateRecord const& candidate_record{record(index)};
+  out.write(m_data + m_footer->m_dot_prefix_offset, m_footer->m_dot_prefix_size);
+  for (size_t location = 0; location < m_footer->m_number_of_locations; ++location)
+  {
+    results_archive::SubgraphEntry const& entry{m_subgraphs[m_locations[location] + subgraph_index(index, location)]};
+    out.write(m_data + entry.m_edges_offset, entry.m_edges_size);
+  }
+  Graph::write_dot_legend(out,
+      string(m_footer->m_legend_rows_offset, m_footer->m_legend_rows_size),
+      string(m_footer->m_strings_offset + candidate_record.m_valid_offset, candidate_record.m_valid_size),
+      std::string());
+  out << "}\n";
+}
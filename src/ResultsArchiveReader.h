@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ResultsArchive.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+// Random access to a results archive (see ResultsArchive.h) that was written by ResultsArchiveWriter.
+//
+// The whole file is mmap-ed. The constructor checks that the footer, the
+// tables and the candidate records are consistent with each other and with
+// the size of the file; the edges and strings are not read until they are used.
+//
+class ResultsArchiveReader
+{
+ private:
+  char const* m_data;                                   // The start of the mapped file.
+  size_t m_size;                                        // The size of the mapped file.
+  results_archive::Footer const* m_footer;              // Points into the mapped file.
+  results_archive::SubgraphEntry const* m_subgraphs;    // Points into the mapped file.
+  uint32_t const* m_locations;                          // Points into the mapped file.
+
+ public:
+  ResultsArchiveReader(std::string const& filename);
+  ~ResultsArchiveReader();
+
+  ResultsArchiveReader(ResultsArchiveReader const&) = delete;
+  ResultsArchiveReader& operator=(ResultsArchiveReader const&) = delete;
+
+  // Accessors.
+  size_t number_of_candidates() const { return m_footer->m_number_of_candidates; }
+  size_t number_of_locations() const { return m_footer->m_number_of_locations; }
+  // Return the record of the candidate with index `index' (not to be confused with the candidate number).
+  results_archive::CandidateRecord const& record(size_t index) const;
+  // Return the subgraph index of location `location' of the candidate with index `index'.
+  uint32_t subgraph_index(size_t index, size_t location) const;
+  // Return the number of rf subgraphs of location `location'.
+  size_t number_of_subgraphs(size_t location) const;
+  // Return the (html) condition under which rf subgraph `subgraph' of location `location' is valid; empty if it is always valid.
+  std::string subgraph_valid(size_t location, size_t subgraph) const;
+
+  // Write the candidate with index `index' as a dot file to out.
+  void write_dot(std::ostream& out, size_t index) const;
+
+ private:
+  std::string string(uint64_t offset, uint64_t size) const;
+  // Return true if size bytes at offset are inside the mapped file.
+  bool in_file(uint64_t offset, uint64_t size) const { return offset <= m_size && size <= m_size - offset; }
+  // Return true if size bytes at offset (relative to Footer::m_strings_offset) are inside the strings section.
+  bool in_strings(uint64_t offset, uint64_t size) const;
+  // Return true if the footer, the tables and all candidate records are consistent.
+  bool is_consistent() const;
+};
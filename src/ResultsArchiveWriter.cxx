@@ -0,0 +1,147 @@
+#include "sys.h"
+#include "ResultsArchiveWriter.h"
+#include "ReadFromLocationSubgraphs.h"
+#include "Graph.h"
+#include "utils/AIAlert.h"
+#include "debug.h"
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+
+ResultsArchiveWriter::ResultsArchiveWriter(std::string const& filename) : m_offset(0), m_footer{}, m_strings(nullptr), m_strings_size(0)
+{
+  m_out.open(filename, std::ios::binary);
+  if (!m_out)
+    THROW_ALERT("Failed to open results archive \"[FILENAME]\" for writing", AIArgs("[FILENAME]", filename));
+  // The valid strings are only known while the candidates are written, but they
+  // are stored after the candidate records; keep them in a temporary file meanwhile.
+  m_strings = std::tmpfile();
+  if (!m_strings)
+    THROW_ALERT("Failed to create a temporary file for results archive \"[FILENAME]\"", AIArgs("[FILENAME]", filename));
+  results_archive::Header header{};
+  std::memcpy(header.m_magic, results_archive::magic, sizeof(header.m_magic));
+  header.m_version = results_archive::version;
+  write(&header, sizeof(header));
+  // The index of the first subgraph of the first location.
+  m_locations.push_back(0);
+}
+
+ResultsArchiveWriter::~ResultsArchiveWriter()
+{
+  if (m_strings)
+    std::fclose(m_strings);
+}
+
+void ResultsArchiveWriter::write(void const* data, size_t size)
+{
+  m_out.write(static_cast<char const*>(data), size);
+  m_offset += size;
+}
+
+void ResultsArchiveWriter::align()
+{
+  // Keep records and tables 8-byte aligned, so they can be accessed directly in the mmap-ed file.
+  static char const padding[8] = {};
+  write(padding, (8 - m_offset % 8) % 8);
+}
+
+uint32_t ResultsArchiveWriter::add_string(std::string const& str)
+{
+  // String offsets are stored as uint32_t.
+  if (m_strings_size + str.size() > UINT32_MAX)
+    THROW_ALERT("The valid strings of the results archive exceed 4 GB");
+  if (std::fwrite(str.data(), 1, str.size(), m_strings) != str.size())
+    THROW_ALERT("Failed to write the valid strings of the results archive");
+  uint32_t offset = m_strings_size;
+  m_strings_size += str.size();
+  return offset;
+}
+
+void ResultsArchiveWriter::write_opsem(Graph const& graph)
+{
+  // Graph::cache_dot_prefix must have been called.
+  ASSERT(!graph.dot_prefix().empty());
+  m_footer.m_dot_prefix_offset = m_offset;
+  m_footer.m_dot_prefix_size = graph.dot_prefix().size();
+  write(graph.dot_prefix().data(), graph.dot_prefix().size());
+  m_footer.m_legend_rows_offset = m_offset;
+  m_footer.m_legend_rows_size = graph.dot_legend_rows().size();
+  write(graph.dot_legend_rows().data(), graph.dot_legend_rows().size());
+}
+
+void ResultsArchiveWriter::add_location(ReadFromLocationSubgraphs const& read_from_location_subgraphs)
+{
+  // All locations must be added before the first candidate.
+  ASSERT(m_footer.m_number_of_candidates == 0);
+  std::ostringstream edges;
+  for (DirectedSubgraph const& read_from_subgraph : read_from_location_subgraphs)
+  {
+    edges.str(std::string());
+    read_from_subgraph.write_dot_edges(edges);
+    std::string const& str{edges.str()};
+    results_archive::SubgraphEntry entry{};
+    entry.m_edges_offset = m_offset;
+    entry.m_edges_size = str.size();
+    write(str.data(), str.size());
+    boolean::Expression const& valid{read_from_subgraph.valid()};
+    std::string const valid_html = valid.is_one() ? std::string() : valid.as_html_string();
+    entry.m_valid_offset = add_string(valid_html);
+    entry.m_valid_size = valid_html.size();
+    m_subgraphs.push_back(entry);
+  }
+  m_locations.push_back(m_subgraphs.size());
+}
+
+void ResultsArchiveWriter::add_candidate(int candidate, RFLocationSubgraphIndices const& subgraph_indices, boolean::Expression const& valid, uint32_t flags)
+{
+  size_t const number_of_locations = m_locations.size() - 1;
+  if (m_footer.m_number_of_candidates == 0)
+  {
+    align();
+    m_footer.m_candidates_offset = m_offset;
+  }
+  results_archive::CandidateRecord record;
+  record.m_candidate = candidate;
+  record.m_flags = flags;
+  std::string const valid_html = valid.is_one() ? std::string() : valid.as_html_string();
+  record.m_valid_offset = add_string(valid_html);
+  record.m_valid_size = valid_html.size();
+  write(&record, sizeof(record));
+  m_record.resize(number_of_locations);
+  for (RFLocation location = subgraph_indices.ibegin(); location != subgraph_indices.iend(); ++location)
+    m_record[location.get_value()] = subgraph_indices[location];
+  write(m_record.data(), m_record.size() * sizeof(uint32_t));
+  ++m_footer.m_number_of_candidates;
+}
+
+void ResultsArchiveWriter::finish()
+{
+  size_t const number_of_locations = m_locations.size() - 1;
+  if (m_footer.m_number_of_candidates == 0)
+  {
+    align();
+    m_footer.m_candidates_offset = m_offset;
+  }
+  m_footer.m_record_size = sizeof(results_archive::CandidateRecord) + number_of_locations * sizeof(uint32_t);
+  m_footer.m_strings_offset = m_offset;
+  std::rewind(m_strings);
+  char buffer[65536];
+  size_t size;
+  while ((size = std::fread(buffer, 1, sizeof(buffer), m_strings)) > 0)
+    write(buffer, size);
+  if (std::ferror(m_strings) || m_offset != m_footer.m_strings_offset + m_strings_size)
+    THROW_ALERT("Failed to read back the valid strings of the results archive");
+  align();
+  m_footer.m_subgraphs_offset = m_offset;
+  m_footer.m_number_of_subgraphs = m_subgraphs.size();
+  write(m_subgraphs.data(), m_subgraphs.size() * sizeof(results_archive::SubgraphEntry));
+  m_footer.m_locations_offset = m_offset;
+  m_footer.m_number_of_locations = number_of_locations;
+  write(m_locations.data(), m_locations.size() * sizeof(uint32_t));
+  align();
+  std::memcpy(m_footer.m_magic, results_archive::magic, sizeof(m_footer.m_magic));
+  write(&m_footer, sizeof(m_footer));
+  m_out.close();
+  if (!m_out)
+    THROW_ALERT("Failed to write results archive");
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ResultsArchive.h"
+#include "RFLocationOrderedSubgraphs.h"
+#include "boolean-expression/BooleanExpression.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Graph;
+class ReadFromLocationSubgraphs;
+
+// Write a results archive (see ResultsArchive.h).
+//
+// Usage:
+//
+//   ResultsArchiveWriter archive(filename);
+//   archive.write_opsem(graph);                        // After Graph::cache_dot_prefix.
+//   for (...)
+//     archive.add_location(read_from_location_subgraphs);
+//   for (...)
+//     archive.add_candidate(candidate, subgraph_indices, valid, flags);
+//   archive.finish();
+//
+class ResultsArchiveWriter
+{
+ private:
+  std::ofstream m_out;                                          // The archive file.
+  uint64_t m_offset;                                            // The current write offset.
+  results_archive::Footer m_footer;                             // The footer, filled in while writing.
+  std::vector<results_archive::SubgraphEntry> m_subgraphs;      // The subgraph table, written by finish().
+  std::vector<uint32_t> m_locations;                            // The location table, written by finish().
+  std::FILE* m_strings;                                         // Temporary file with the valid strings, copied into the archive by finish().
+  uint64_t m_strings_size;                                      // The number of bytes written to m_strings.
+  std::vector<uint32_t> m_record;                               // Scratch buffer for the subgraph indices of a candidate.
+
+ public:
+  ResultsArchiveWriter(std::string const& filename);
+  ~ResultsArchiveWriter();
+
+  ResultsArchiveWriter(ResultsArchiveWriter const&) = delete;
+  ResultsArchiveWriter& operator=(ResultsArchiveWriter const&) = delete;
+
+  // Write the (cached) dot prefix and legend rows of graph.
+  void write_opsem(Graph const& graph);
+
+  // Write the rf subgraphs of the next location.
+  void add_location(ReadFromLocationSubgraphs const& read_from_location_subgraphs);
+
+  // Write the record of a candidate; the subgraph index of each location is read from subgraph_indices.
+  void add_candidate(int candidate, RFLocationSubgraphIndices const& subgraph_indices, boolean::Expression const& valid, uint32_t flags);
+
+  // Write the tables and the footer.
+  void finish();
+
+ private:
+  void write(void const* data, size_t size);
+  void align();
+  uint32_t add_string(std::string const& str);
+};
@@ -0,0 +1,168 @@
+#include "sys.h"
+#include "Server.h"
+#include "cppmem_analyzer.h"
+#include "NDJSONWriter.h"
+#include "debug.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// The largest accepted request.
+constexpr size_t max_source_size = 16 * 1024 * 1024;
+
+} // namespace
+
+bool Server::serve(int in_fd, int out_fd)
+{
+  m_input.clear();
+  m_input_pos = 0;
+  std::ostringstream answer;
+  NDJSONWriter ndjson_writer(answer);
+  cppmem::Options options;
+  options.filename = "<request>";
+  options.parser = &m_parser;
+  bool error = false;
+  while (read_request(in_fd, error))
+  {
+    cppmem::Result const result = cppmem::analyze(m_source, options);
+    answer.str(std::string());
+    ndjson_writer.write_result(result);
+    if (!write_all(out_fd, answer.str()))
+      return false;
+  }
+  return !error;
+}
+
+bool Server::serve_socket(char const* socket_path)
+{
+  sockaddr_un address;
+  if (std::strlen(socket_path) >= sizeof(address.sun_path))
+  {
+    std::cerr << "Socket path \"" << socket_path << "\" is too long.\n";
+    return false;
+  }
+  int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd == -1)
+  {
+    std::cerr << "socket: " << std::strerror(errno) << '\n';
+    return false;
+  }
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, socket_path);
+  unlink(socket_path);
+  // Don't die when a client closes its connection before reading the answer.
+  std::signal(SIGPIPE, SIG_IGN);
+  if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(listen_fd, 8) == -1)
+  {
+    std::cerr << "Failed to listen on \"" << socket_path << "\": " << std::strerror(errno) << '\n';
+    close(listen_fd);
+    return false;
+  }
+  for (;;)
+  {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd == -1)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      std::cerr << "accept: " << std::strerror(errno) << '\n';
+      break;
+    }
+    if (!serve(fd, fd))
+      Dout(dc::warning, "Dropped connection after an error.");
+    close(fd);
+  }
+  close(listen_fd);
+  unlink(socket_path);
+  return false;
+}
+
+bool Server::read_request(int fd, bool& error)
+{
+  // Read the length line.
+  size_t eol;
+  while ((eol = m_input.find('\n', m_input_pos)) == std::string::npos)
+  {
+    if (m_input.size() - m_input_pos > 20)     // Too long to be a length.
+    {
+      error = true;
+      return false;
+    }
+    if (!fill(fd, error))
+    {
+      // End-of-file is only an error in the middle of a request.
+      if (m_input_pos != m_input.size())
+        error = true;
+      return false;
+    }
+  }
+  char const* const length_begin = m_input.data() + m_input_pos;
+  char* length_end;
+  unsigned long long const length = std::strtoull(length_begin, &length_end, 10);
+  if (length_end == length_begin || length_end != m_input.data() + eol || length > max_source_size)
+  {
+    error = true;
+    return false;
+  }
+  m_input_pos = eol + 1;
+
+  // Read the source.
+  while (m_input.size() - m_input_pos < length)
+    if (!fill(fd, error))
+    {
+      error = true;
+      return false;
+    }
+  m_source.assign(m_input, m_input_pos, length);
+  m_input_pos += length;
+  return true;
+}
+
+bool Server::fill(int fd, bool& error)
+{
+  // Discard the processed input.
+  m_input.erase(0, m_input_pos);
+  m_input_pos = 0;
+  char buf[65536];
+  ssize_t len;
+  while ((len = read(fd, buf, sizeof(buf))) == -1)
+  {
+    if (errno != EINTR)
+    {
+      error = true;
+      return false;
+    }
+  }
+  if (len == 0)
+    return false;
+  m_input.append(buf, len);
+  return true;
+}
+
+//static
+bool Server::write_all(int fd, std::string const& data)
+{
+  char const* ptr = data.data();
+  size_t remaining = data.size();
+  while (remaining > 0)
+  {
+    ssize_t len = write(fd, ptr, remaining);
+    if (len == -1)
+    {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    ptr += len;
+    remaining -= len;
+  }
+  return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "cppmem_parser.h"
+#include <string>
+
+// Analyze tests, one after another, in a single long running process (cppmem --serve).
+//
+// A request is the length of the source in bytes, written as a decimal
+// number and terminated by a newline, followed by exactly that many bytes
+// of cppmem source. For example:
+//
+//   43\n
+//   int main() { int x = 0; { x = 1; } x = 2; }
+//
+// Every request is answered with a single line of JSON (see
+// NDJSONWriter::write_result). The grammar is constructed only once
+// and reused for all requests; all other state is per request.
+//
+// Requests are read from stdin (answers go to stdout), or from the
+// connections made to a Unix-domain socket; connections are served one
+// at a time and each connection can send any number of requests.
+//
+class Server
+{
+ private:
+  cppmem::Parser m_parser;              // Reused for every request.
+  std::string m_input;                  // Buffered input of the current connection.
+  size_t m_input_pos;                   // Start of the unprocessed input in m_input.
+  std::string m_source;                 // The source of the current request.
+
+ public:
+  Server() : m_input_pos(0) { }
+
+  // Serve requests read from in_fd and write the answers to out_fd, until end-of-file on in_fd.
+  // Returns false on a read/write error or a malformed request.
+  bool serve(int in_fd, int out_fd);
+
+  // Listen on the Unix-domain socket socket_path and serve all connections. Only returns on error.
+  bool serve_socket(char const* socket_path);
+
+ private:
+  // Read the next request into m_source. Returns false at end-of-file or on error.
+  bool read_request(int fd, bool& error);
+  // Read more input from fd into m_input. Returns false at end-of-file or on error.
+  bool fill(int fd, bool& error);
+  // Write all of data to fd.
+  static bool write_all(int fd, std::string const& data);
+};
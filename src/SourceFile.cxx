@@ -0,0 +1,60 @@
+#include "sys.h"
+#include "SourceFile.h"
+#include "debug.h"
+#include <cstring>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+SourceFile::SourceFile(char const* filepath) : m_data(""), m_size(0), m_mapped(false), m_is_open(false)
+{
+  bool const is_stdin = std::strcmp(filepath, "-") == 0;
+  int fd = is_stdin ? STDIN_FILENO : open(filepath, O_RDONLY);
+  if (fd == -1)
+    return;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+  {
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      Dout(dc::notice, "Mapped " << st.st_size << " bytes of \"" << filepath << "\".");
+      m_data = static_cast<char const*>(data);
+      m_size = st.st_size;
+      m_mapped = true;
+      m_is_open = true;
+    }
+  }
+  // Fall back to reading the input (stdin, pipes, or when mmap failed).
+  if (!m_mapped)
+    m_is_open = read_all(fd);
+  if (!is_stdin)
+    close(fd);
+}
+
+SourceFile::~SourceFile()
+{
+  if (m_mapped)
+    munmap(const_cast<char*>(m_data), m_size);
+}
+
+bool SourceFile::read_all(int fd)
+{
+  char buf[65536];
+  ssize_t len;
+  while ((len = read(fd, buf, sizeof(buf))) != 0)
+  {
+    if (len == -1)
+    {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    m_buffer.append(buf, len);
+  }
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+  return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// The contents of an input file.
+//
+// Regular files are mapped read-only into memory, so that the parser
+// can work directly on the mapping without making a copy. Anything
+// else (stdin, pipes) is read into a buffer instead.
+//
+// The filepath "-" means stdin.
+//
+class SourceFile
+{
+ private:
+  char const* m_data;                   // The start of the contents.
+  size_t m_size;                        // The size of the contents.
+  bool m_mapped;                        // Set if m_data points to a mapping that must be unmapped.
+  bool m_is_open;                       // Set if the file could be read.
+  std::string m_buffer;                 // Used when the input can't be mapped.
+
+ public:
+  SourceFile(char const* filepath);
+  ~SourceFile();
+
+  SourceFile(SourceFile const&) = delete;
+  SourceFile& operator=(SourceFile const&) = delete;
+
+  // Accessors.
+  bool is_open() const { return m_is_open; }
+  char const* begin() const { return m_data; }
+  char const* end() const { return m_data + m_size; }
+  std::string_view view() const { return { m_data, m_size }; }
+
+ private:
+  bool read_all(int fd);
+};
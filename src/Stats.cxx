@@ -0,0 +1,102 @@
+#include "sys.h"
+#include "Stats.h"
+#include <ostream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace stats {
+
+namespace {
+
+std::mutex s_threads_mutex;                                     // Protects s_threads and s_exited.
+std::vector<ThreadCounters const*> s_threads;                   // The counters of all running threads that counted something.
+uint64_t s_exited[number_of_counters];                          // The sum of the counters of all threads that exited.
+
+} // namespace
+
+thread_local ThreadCounters thread_counters;
+
+ThreadCounters::ThreadCounters()
+{
+  for (std::atomic<uint64_t>& count : m_counters)
+    count.store(0, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(s_threads_mutex);
+  s_threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+  std::lock_guard<std::mutex> lock(s_threads_mutex);
+  for (int counter = 0; counter < number_of_counters; ++counter)
+    s_exited[counter] += m_counters[counter].load(std::memory_order_relaxed);
+  s_threads.erase(std::find(s_threads.begin(), s_threads.end(), this));
+}
+
+uint64_t total(Counter counter)
+{
+  std::lock_guard<std::mutex> lock(s_threads_mutex);
+  uint64_t sum = s_exited[counter];
+  for (ThreadCounters const* thread : s_threads)
+    sum += thread->m_counters[counter].load(std::memory_order_relaxed);
+  return sum;
+}
+
+char const* name(Counter counter)
+{
+  switch (counter)
+  {
+    case rf_combinations:
+      return "rf_combinations";
+    case rf_candidates:
+      return "rf_candidates";
+    case location_clusters:
+      return "location_clusters";
+    case coherence_rejected_subgraphs:
+      return "coherence_rejected_subgraphs";
+    case coherence_rejected:
+      return "coherence_rejected";
+    case loop_rejected:
+      return "loop_rejected";
+    case loop_detected_calls:
+      return "loop_detected_calls";
+    case dfs_node_visits:
+      return "dfs_node_visits";
+    case dfs_edges_followed:
+      return "dfs_edges_followed";
+    case properties_merge:
+      return "properties_merge";
+    case property_convert_kept:
+      return "property_convert_kept";
+    case property_convert_dropped:
+      return "property_convert_dropped";
+    case expression_times:
+      return "expression_times";
+    case expression_plus:
+      return "expression_plus";
+    case edge_allocations:
+      return "edge_allocations";
+    case write_png_file:
+      return "write_png_file";
+    case number_of_counters:
+      break;
+  }
+  return "unknown";
+}
+
+void print_table(std::ostream& os)
+{
+  for (int counter = 0; counter < number_of_counters; ++counter)
+    os << std::left << std::setw(30) << name(static_cast<Counter>(counter)) << std::right << std::setw(14) << total(static_cast<Counter>(counter)) << '\n';
+}
+
+void print_json(std::ostream& os)
+{
+  os << "{\"stats\":{";
+  for (int counter = 0; counter < number_of_counters; ++counter)
+    os << (counter == 0 ? "\"" : ",\"") << name(static_cast<Counter>(counter)) << "\":" << total(static_cast<Counter>(counter));
+  os << "}}\n";
+}
+
+} // namespace stats
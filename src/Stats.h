@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+// Cheap counters of events in the hot paths of the analysis (cppmem --stats).
+//
+// Every thread counts into its own (thread_local) array, so that counting
+// is a single increment without a read-modify-write or locking; the
+// counters are always compiled in. Each array registers itself, and a
+// report shows the sum over all threads (including threads that already
+// exited) of everything they analyzed so far. The counters are relaxed
+// atomics only so that a report may read them while other threads count.
+//
+namespace stats {
+
+enum Counter
+{
+  rf_combinations,              // Combinations of rf subgraphs enumerated.
+  rf_candidates,                // Consistent rf candidates found.
+  location_clusters,            // Independent clusters of locations whose rf combinations were enumerated separately (see LocationClusters).
+  coherence_rejected_subgraphs, // Rf subgraphs of a single location that were rejected by the coherence pre-check.
+  coherence_rejected,           // Combinations of rf subgraphs that were rejected by the coherence pre-check (and thus never enumerated).
+  loop_rejected,                // Combinations that were rejected because of the condition returned by ReadFromGraph::loop_detected.
+  loop_detected_calls,          // Calls to ReadFromGraph::loop_detected (each starts a depth-first search).
+  dfs_node_visits,              // Calls to ReadFromGraph::dfs (each visits one node).
+  dfs_edges_followed,           // Edges followed by ReadFromGraph::dfs.
+  properties_merge,             // Calls to Properties::merge.
+  property_convert_kept,        // Calls to Property::convert that returned true.
+  property_convert_dropped,     // Calls to Property::convert that returned false.
+  expression_times,             // boolean::Expression multiplications during loop detection.
+  expression_plus,              // boolean::Expression additions during loop detection.
+  edge_allocations,             // Edge objects created.
+  write_png_file,               // Calls to Graph::write_png_file.
+  number_of_counters
+};
+
+// The counters of one thread.
+struct ThreadCounters
+{
+  std::atomic<uint64_t> m_counters[number_of_counters]; // Only written by the owning thread.
+
+  ThreadCounters();                     // Register this thread.
+  ~ThreadCounters();                    // Add the counts of this thread to the totals of exited threads and unregister.
+};
+
+extern thread_local ThreadCounters thread_counters;
+
+// Count n events.
+inline void add(Counter counter, uint64_t n)
+{
+  std::atomic<uint64_t>& count{thread_counters.m_counters[counter]};
+  count.store(count.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Count one event.
+inline void increment(Counter counter) { add(counter, 1); }
+
+// Return the sum of counter over all threads.
+uint64_t total(Counter counter);
+
+// Return the (JSON friendly) name of counter.
+char const* name(Counter counter);
+
+// Print the counters (summed over all threads) as a two column table.
+void print_table(std::ostream& os);
+
+// Print the counters as a single line JSON object: {"stats":{"rf_combinations":12,...}}.
+void print_json(std::ostream& os);
+
+} // namespace stats
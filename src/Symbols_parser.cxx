@@ -226,10 +226,7 @@ void SymbolsImpl::print(boost::spirit::qi::symbols<char, ast::tag>& table) const
   table.for_each(symbol_printer);
 }
 
-namespace {
-
-SingletonInstance<parser::Symbols> dummy __attribute__ ((__unused__));
-
-}
+//static
+thread_local Symbols* Symbols::s_instance;
 
 } // namespace parser
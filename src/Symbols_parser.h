@@ -1,23 +1,38 @@
 #pragma once
 
 #include "ast.h"
-#include "utils/Singleton.h"
+#include "debug.h"
+
+class AnalysisSession;
 
 namespace parser {
 
 class SymbolsImpl;
 
-class Symbols : public Singleton<Symbols>
+// The symbol tables of the parser.
+//
+// Symbols is owned by an AnalysisSession (or by a reused cppmem::Parser);
+// Symbols::instance() returns the Symbols of the current session of the
+// calling thread.
+//
+class Symbols
 {
-  friend_Instance;
- private:
+  friend class ::AnalysisSession;
+ public:
   Symbols();
   ~Symbols();
   Symbols(Symbols const&) = delete;
 
+ private:
+  static thread_local Symbols* s_instance;      // The Symbols of the current AnalysisSession of this thread.
+
  public:
   SymbolsImpl* const m_impl;
 
+ public:
+  // Return the Symbols of the current AnalysisSession.
+  static Symbols& instance() { ASSERT(s_instance); return *s_instance; }
+
  public:
   void function(ast::function const& name);
   void vardecl(ast::memory_location const& memory_location);
@@ -143,9 +143,17 @@ void Thread::begin_branch_true(EvaluationNodePtrConditionPairs& unconnected_head
   DoutEntering(dc::branch, "Thread::begin_branch_true(" << *condition << ")");
   // Here we are directly after an 'if ()' statement.
   // `condition` is the conditional expression of a selection statement (and assumed true here).
+  // Everything in either branch is control dependent on the reads that this condition depends on,
+  // as well as on those of the enclosing selection statements.
+  EvaluationNodePtrs control_dependencies;
+  if (!m_branch_info_stack.empty())
+    control_dependencies = m_branch_info_stack.top().control_dependencies();
+  for (NodePtr const& read_node : Context::instance().data_dependencies(*condition))
+    if (std::find(control_dependencies.begin(), control_dependencies.end(), read_node.get_iterator()) == control_dependencies.end())
+      control_dependencies.push_back(read_node);
   ConditionalBranch conditional_branch{Context::instance().add_condition(std::move(condition))};
   // Create a new BranchInfo for this selection statement.
-  m_branch_info_stack.emplace(conditional_branch);
+  m_branch_info_stack.emplace(conditional_branch, std::move(control_dependencies));
   Dout(dc::branch, "Added " << m_branch_info_stack.top() << " to m_branch_info_stack.");
 
   // Prepare the unconnected heads for the false-branch.
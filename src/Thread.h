@@ -59,6 +59,8 @@ class Thread : public AIRefCount
   bool is_joined() const { return m_is_joined; }
   bool in_true_branch() const { return !m_branch_info_stack.empty() && m_branch_info_stack.top().in_true_branch(); }
   bool in_false_branch() const { return !m_branch_info_stack.empty() && !m_branch_info_stack.top().in_true_branch(); }
+  // The reads that the conditionals of the enclosing selection statements depend on, or nullptr when not in a branch.
+  EvaluationNodePtrs const* control_dependencies() const { return m_branch_info_stack.empty() ? nullptr : &m_branch_info_stack.top().control_dependencies(); }
 
   // Called at sequence-points.
   void detect_full_expression_start();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "debug.h"
+#include "Edge.h"
+#include "boolean-expression/BooleanExpression.h"
+#include <vector>
+
+// The visited state of all opsem (sb and asw) edges, as used by FollowVisitedOpsemHeads.
+//
+// Every traversal marks the opsem edges that it visits, together with the
+// condition under which they are visited. Rather than storing that in the
+// (shared) Edge objects, it is stored here, using the dense Edge::opsem_index()
+// as index. The arrays are allocated once and never need to be cleared:
+// every traversal uses a new generation (see next_generation()) and an entry
+// only counts as visited if it was stamped with the current generation.
+//
+// Hence the graph is not altered by traversals, and independent traversals
+// can run concurrently, each with its own VisitedEdges object.
+//
+class VisitedEdges
+{
+ private:
+  std::vector<int> m_generation;                        // The generation that each edge was last visited in.
+  std::vector<boolean::Expression> m_condition;         // The condition under which each edge is visited (if m_generation is current).
+  int m_last_generation;                                // The last generation returned by next_generation().
+
+ public:
+  // Construct an object for number_of_opsem_edges edges (see Action::initialize_post_opsem).
+  VisitedEdges(int number_of_opsem_edges) : m_generation(number_of_opsem_edges, 0), m_condition(number_of_opsem_edges), m_last_generation(0) { }
+
+  // Return a new generation, for which no edge is visited yet.
+  int next_generation() { return ++m_last_generation; }
+
+  // Mark edge as visited under path_condition (times the condition of the edge itself).
+  void visit(Edge const* edge, int visited_generation, boolean::Expression const& path_condition)
+  {
+    int const index = edge->opsem_index();
+    ASSERT(0 <= index && index < (int)m_generation.size());
+    // Multiply the path_condition so far with the condition of this edge.
+    boolean::Expression path_condition_including_edge{path_condition * edge->condition().as_product()};
+    if (m_generation[index] != visited_generation)
+    {
+      Dout(dc::visited, "Setting visited condition to " << path_condition_including_edge << " because new visited_generation " <<
+          visited_generation << " is unequal old value " << m_generation[index]);
+      m_condition[index] = std::move(path_condition_including_edge);
+      m_generation[index] = visited_generation;
+    }
+    else
+    {
+      Dout(dc::visited|continued_cf, "Updating visited condition from " << m_condition[index] << ' ');
+      m_condition[index] += path_condition_including_edge;
+      Dout(dc::finish, "to " << m_condition[index]);
+    }
+  }
+
+  // Return true if edge was visited in generation visited_generation.
+  bool is_visited(Edge const* edge, int visited_generation) const { return m_generation[edge->opsem_index()] == visited_generation; }
+
+  // Return the condition under which edge was visited in generation visited_generation (zero if it wasn't visited).
+  boolean::Expression const& visited_condition(Edge const* edge, int visited_generation) const
+  {
+    int const index = edge->opsem_index();
+    // If a recursive algorithm incremented visited_generation and wrote where we are still
+    // checking if edges have been visited, then it might have overwritten our value and
+    // we'd return false where we should have returned true.
+    ASSERT(m_generation[index] <= visited_generation);
+    return m_generation[index] == visited_generation ? m_condition[index] : boolean::Expression::zero();
+  }
+};
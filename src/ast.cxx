@@ -11,10 +11,16 @@ namespace ast {
 
 std::ostream& operator<<(std::ostream& os, tag const& tag)
 {
-  os << parser::Symbols::instance().tag_to_string(tag);
+  if (CanonicalNames* canonical_names = CanonicalNames::current())
+    os << '_' << canonical_names->tag_number(tag);
+  else
+    os << parser::Symbols::instance().tag_to_string(tag);
   return os;
 }
 
+//static
+thread_local CanonicalNames* CanonicalNames::s_current;
+
 std::ostream& operator<<(std::ostream& os, type const& type)
 {
   switch (type.m_type)
@@ -52,13 +58,19 @@ std::ostream& operator<<(std::ostream& os, unique_lock_decl const& unique_lock_d
 
 std::ostream& operator<<(std::ostream& os, register_location const& register_location)
 {
-  os << 'r' << register_location.m_id;
+  if (CanonicalNames* canonical_names = CanonicalNames::current())
+    os << 'r' << canonical_names->register_number(register_location.m_id);
+  else
+    os << 'r' << register_location.m_id;
   return os;
 }
 
 std::ostream& operator<<(std::ostream& os, memory_location const& memory_location)
 {
-  os << memory_location.m_name;
+  if (CanonicalNames* canonical_names = CanonicalNames::current())
+    os << '_' << canonical_names->tag_number(memory_location);
+  else
+    os << memory_location.m_name;
   return os;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <map>
 
 namespace ast {
 
@@ -15,4 +16,31 @@ struct tag
   friend bool operator!=(tag const& tag1, tag const& tag2) { return tag1.id != tag2.id; }
 };
 
+// While an object of this type exists, the variables and registers printed by
+// the current thread are written with canonical names ("_0", "_1", ... and
+// "r0", "r1", ..., numbered in the order in which they are first printed)
+// instead of the names used in the source code.
+class CanonicalNames
+{
+ private:
+  std::map<int, int> m_tags;                            // Canonical number as function of the tag id.
+  std::map<unsigned int, int> m_registers;              // Canonical number as function of the register number.
+  CanonicalNames* m_previous;                           // The object that was active before this one.
+  static thread_local CanonicalNames* s_current;        // The active object of this thread, if any.
+
+ public:
+  CanonicalNames() : m_previous(s_current) { s_current = this; }
+  ~CanonicalNames() { s_current = m_previous; }
+
+  CanonicalNames(CanonicalNames const&) = delete;
+  CanonicalNames& operator=(CanonicalNames const&) = delete;
+
+  static CanonicalNames* current() { return s_current; }
+
+  // Return the canonical number of tag.
+  int tag_number(tag const& tag) { return m_tags.emplace(tag.id, m_tags.size()).first->second; }
+  // Return the canonical number of register r<register_number>.
+  int register_number(unsigned int register_number) { return m_registers.emplace(register_number, m_registers.size()).first->second; }
+};
+
 } // namespace ast
@@ -0,0 +1,19 @@
+// 2+2W: two threads that each write both locations, in opposite order.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+      y.store(2, mo_relaxed);
+    }
+  |||
+    {
+      y.store(1, mo_relaxed);
+      x.store(2, mo_relaxed);
+    }
+  }}}
+  r1 = x.load(mo_relaxed);
+  r2 = y.load(mo_relaxed);
+}
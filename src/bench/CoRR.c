@@ -0,0 +1,15 @@
+// CoRR (read-read coherence): r1 == 1 && r2 == 0 is forbidden.
+int main()
+{
+  atomic_int x = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+    }
+  |||
+    {
+      r1 = x.load(mo_relaxed);
+      r2 = x.load(mo_relaxed);
+    }
+  }}}
+}
@@ -0,0 +1,24 @@
+// CoRR2: two readers must agree on the order of two writes to the same location.
+int main()
+{
+  atomic_int x = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+    }
+  |||
+    {
+      x.store(2, mo_relaxed);
+    }
+  |||
+    {
+      r1 = x.load(mo_relaxed);
+      r2 = x.load(mo_relaxed);
+    }
+  |||
+    {
+      r3 = x.load(mo_relaxed);
+      r4 = x.load(mo_relaxed);
+    }
+  }}}
+}
@@ -0,0 +1,26 @@
+// IRIW (independent reads of independent writes) with acquire loads:
+// the readers may disagree about the order of the two writes.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_release);
+    }
+  |||
+    {
+      y.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = x.load(mo_acquire);
+      r2 = y.load(mo_acquire);
+    }
+  |||
+    {
+      r3 = y.load(mo_acquire);
+      r4 = x.load(mo_acquire);
+    }
+  }}}
+}
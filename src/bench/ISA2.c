@@ -0,0 +1,23 @@
+// ISA2: a release/acquire chain through three threads; if r1 == 1 and r2 == 1 then r3 must be 1.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  atomic_int z = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+      y.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = y.load(mo_acquire);
+      z.store(1, mo_release);
+    }
+  |||
+    {
+      r2 = z.load(mo_acquire);
+      r3 = x.load(mo_relaxed);
+    }
+  }}}
+}
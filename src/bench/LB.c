@@ -0,0 +1,17 @@
+// LB (load buffering) with relaxed accesses: r1 == 1 && r2 == 1 is allowed.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      r1 = x.load(mo_relaxed);
+      y.store(1, mo_relaxed);
+    }
+  |||
+    {
+      r2 = y.load(mo_relaxed);
+      x.store(1, mo_relaxed);
+    }
+  }}}
+}
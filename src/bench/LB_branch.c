@@ -0,0 +1,19 @@
+// LB (load buffering) where every store depends on the value that was read.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      r1 = x.load(mo_relaxed);
+      if (r1 == 1)
+        y.store(1, mo_relaxed);
+    }
+  |||
+    {
+      r2 = y.load(mo_relaxed);
+      if (r2 == 1)
+        x.store(1, mo_relaxed);
+    }
+  }}}
+}
@@ -0,0 +1,17 @@
+// MP (message passing) with release/acquire: if r1 == 1 then r2 must be 1.
+int main()
+{
+  atomic_int data = 0;
+  atomic_int flag = 0;
+  {{{
+    {
+      data.store(1, mo_relaxed);
+      flag.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = flag.load(mo_acquire);
+      r2 = data.load(mo_relaxed);
+    }
+  }}}
+}
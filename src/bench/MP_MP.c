@@ -0,0 +1,30 @@
+// Two independent MP (message passing) tests: the locations x0 and f0 never interact
+// with x1 and f1, so their rf subgraphs are enumerated as two separate clusters.
+int main()
+{
+  atomic_int x0 = 0;
+  atomic_int f0 = 0;
+  atomic_int x1 = 0;
+  atomic_int f1 = 0;
+  {{{
+    {
+      x0.store(1, mo_relaxed);
+      f0.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = f0.load(mo_acquire);
+      r2 = x0.load(mo_relaxed);
+    }
+  |||
+    {
+      x1.store(1, mo_relaxed);
+      f1.store(1, mo_release);
+    }
+  |||
+    {
+      r3 = f1.load(mo_acquire);
+      r4 = x1.load(mo_relaxed);
+    }
+  }}}
+}
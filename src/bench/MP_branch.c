@@ -0,0 +1,18 @@
+// MP (message passing) where the reader only reads the data when it saw the flag.
+int main()
+{
+  int data = 0;
+  atomic_int flag = 0;
+  {{{
+    {
+      data = 1;
+      flag.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = flag.load(mo_acquire);
+      if (r1 == 1)
+        r2 = data;
+    }
+  }}}
+}
@@ -0,0 +1,21 @@
+// MP (message passing) with release/consume: the store to y carries a data dependency,
+// and the load of data a control dependency, on the consume load of flag.
+int main()
+{
+  atomic_int data = 0;
+  atomic_int flag = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      data.store(1, mo_relaxed);
+      flag.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = flag.load(mo_consume);
+      y.store(r1 + 1, mo_relaxed);
+      if (r1 == 1)
+        r2 = data.load(mo_relaxed);
+    }
+  }}}
+}
@@ -0,0 +1,23 @@
+// MP (message passing) where both threads protect their accesses with a mutex.
+std::mutex m;
+
+int main()
+{
+  int data = 0;
+  int flag = 0;
+  {{{
+    {
+      m.lock();
+      data = 1;
+      flag = 1;
+      m.unlock();
+    }
+  |||
+    {
+      m.lock();
+      r1 = flag;
+      r2 = data;
+      m.unlock();
+    }
+  }}}
+}
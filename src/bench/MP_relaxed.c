@@ -0,0 +1,17 @@
+// MP (message passing) with only relaxed accesses: r1 == 1 && r2 == 0 is allowed.
+int main()
+{
+  atomic_int data = 0;
+  atomic_int flag = 0;
+  {{{
+    {
+      data.store(1, mo_relaxed);
+      flag.store(1, mo_relaxed);
+    }
+  |||
+    {
+      r1 = flag.load(mo_relaxed);
+      r2 = data.load(mo_relaxed);
+    }
+  }}}
+}
@@ -0,0 +1,18 @@
+// R: a write followed by a read on one side, two writes on the other.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_seq_cst);
+      y.store(1, mo_seq_cst);
+    }
+  |||
+    {
+      y.store(2, mo_seq_cst);
+      r1 = x.load(mo_seq_cst);
+    }
+  }}}
+  r2 = y.load(mo_relaxed);
+}
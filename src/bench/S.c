@@ -0,0 +1,18 @@
+// S: if r1 == 1 then the store x = 1 must be coherence-after the store x = 2.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(2, mo_relaxed);
+      y.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = y.load(mo_acquire);
+      x.store(1, mo_relaxed);
+    }
+  }}}
+  r2 = x.load(mo_relaxed);
+}
@@ -0,0 +1,17 @@
+// SB (store buffering) with seq_cst accesses: r1 == 0 && r2 == 0 is forbidden.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_seq_cst);
+      r1 = y.load(mo_seq_cst);
+    }
+  |||
+    {
+      y.store(1, mo_seq_cst);
+      r2 = x.load(mo_seq_cst);
+    }
+  }}}
+}
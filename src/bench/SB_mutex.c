@@ -0,0 +1,27 @@
+// SB (store buffering) where every access is protected by the same mutex.
+std::mutex m;
+
+int main()
+{
+  int x = 0;
+  int y = 0;
+  {{{
+    {
+      m.lock();
+      x = 1;
+      m.unlock();
+      m.lock();
+      r1 = y;
+      m.unlock();
+    }
+  |||
+    {
+      m.lock();
+      y = 1;
+      m.unlock();
+      m.lock();
+      r2 = x;
+      m.unlock();
+    }
+  }}}
+}
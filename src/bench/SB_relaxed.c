@@ -0,0 +1,17 @@
+// SB (store buffering) with relaxed accesses: r1 == 0 && r2 == 0 is allowed.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+      r1 = y.load(mo_relaxed);
+    }
+  |||
+    {
+      y.store(1, mo_relaxed);
+      r2 = x.load(mo_relaxed);
+    }
+  }}}
+}
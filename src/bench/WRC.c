@@ -0,0 +1,21 @@
+// WRC (write-to-read causality): if r1 == 1 and r2 == 1 then r3 must be 1.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int y = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+    }
+  |||
+    {
+      r1 = x.load(mo_acquire);
+      y.store(1, mo_release);
+    }
+  |||
+    {
+      r2 = y.load(mo_acquire);
+      r3 = x.load(mo_relaxed);
+    }
+  }}}
+}
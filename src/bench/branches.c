@@ -0,0 +1,35 @@
+// A thread with many conditional branches, resulting in a large opsem graph with many path conditions.
+int main()
+{
+  atomic_int x = 0;
+  int y = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+      x.store(2, mo_relaxed);
+      x.store(3, mo_relaxed);
+      x.store(4, mo_relaxed);
+    }
+  |||
+    {
+      r1 = x.load(mo_relaxed);
+      if (r1 == 1)
+        y = 1;
+      if (r1 == 2)
+        y = 2;
+      if (r1 == 3)
+        y = 3;
+      if (r1 == 4)
+        y = 4;
+      r2 = x.load(mo_relaxed);
+      if (r2 == 1)
+        y = 1;
+      if (r2 == 2)
+        y = 2;
+      if (r2 == 3)
+        y = 3;
+      if (r2 == 4)
+        y = 4;
+    }
+  }}}
+}
@@ -0,0 +1,57 @@
+// A long chain of sequenced actions in one thread (deep Depth-First-Search in ReadFromGraph::dfs).
+// The analysis supports at most 64 actions, so the chain is as long as fits.
+int main()
+{
+  atomic_int x = 0;
+  atomic_int flag = 0;
+  {{{
+    {
+      x.store(1, mo_relaxed);
+      x.store(2, mo_relaxed);
+      x.store(3, mo_relaxed);
+      x.store(4, mo_relaxed);
+      x.store(5, mo_relaxed);
+      x.store(6, mo_relaxed);
+      x.store(7, mo_relaxed);
+      x.store(8, mo_relaxed);
+      x.store(9, mo_relaxed);
+      x.store(10, mo_relaxed);
+      x.store(11, mo_relaxed);
+      x.store(12, mo_relaxed);
+      x.store(13, mo_relaxed);
+      x.store(14, mo_relaxed);
+      x.store(15, mo_relaxed);
+      x.store(16, mo_relaxed);
+      x.store(17, mo_relaxed);
+      x.store(18, mo_relaxed);
+      x.store(19, mo_relaxed);
+      x.store(20, mo_relaxed);
+      x.store(21, mo_relaxed);
+      x.store(22, mo_relaxed);
+      x.store(23, mo_relaxed);
+      x.store(24, mo_relaxed);
+      x.store(25, mo_relaxed);
+      x.store(26, mo_relaxed);
+      x.store(27, mo_relaxed);
+      x.store(28, mo_relaxed);
+      x.store(29, mo_relaxed);
+      x.store(30, mo_relaxed);
+      x.store(31, mo_relaxed);
+      x.store(32, mo_relaxed);
+      x.store(33, mo_relaxed);
+      x.store(34, mo_relaxed);
+      x.store(35, mo_relaxed);
+      x.store(36, mo_relaxed);
+      x.store(37, mo_relaxed);
+      x.store(38, mo_relaxed);
+      x.store(39, mo_relaxed);
+      x.store(40, mo_relaxed);
+      flag.store(1, mo_release);
+    }
+  |||
+    {
+      r1 = flag.load(mo_acquire);
+      r2 = x.load(mo_relaxed);
+    }
+  }}}
+}
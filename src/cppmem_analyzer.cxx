@@ -0,0 +1,707 @@
+#include "sys.h"
+#include "cppmem_analyzer.h"
+#include "cppmem_parser.h"
+#include "execute.h"
+#include "ast.h"
+#include "position_handler.h"
+#include "AnalysisSession.h"
+#include "Graph.h"
+#include "Context.h"
+#include "FollowUniqueOpsemTails.h"
+#include "FilterAllActions.h"
+#include "ReadFromLoopsPerLocation.h"
+#include "ReadFromGraph.h"
+#include "ReadFromLocationSubgraphs.h"
+#include "LocationClusters.h"
+#include "VisitedEdges.h"
+#include "CandidateDeduplicator.h"
+#include "FNV1a.h"
+#include "AllocationCounter.h"
+#include "Stats.h"
+#include "boolean-expression/TruthProduct.h"
+#include "utils/AIAlert.h"
+#include "utils/MultiLoop.h"
+#include <boost/variant/get.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+namespace cppmem {
+
+namespace {
+
+// Measures the time spent, and the memory allocated, in the different phases of analyze().
+class Profiler
+{
+ private:
+  using clock_type = std::chrono::steady_clock;
+  Profile& m_profile;
+  clock_type::time_point m_start;
+  allocation_counter::Counts m_start_counts;
+
+ public:
+  Profiler(Profile& profile) : m_profile(profile), m_start(clock_type::now()), m_start_counts(allocation_counter::counts)
+  {
+    m_profile.allocations_counted = allocation_counter::enabled;
+  }
+
+  // Add everything since the previous call (or construction) to phase.
+  void lap(Phase phase)
+  {
+    clock_type::time_point const now = clock_type::now();
+    allocation_counter::Counts const counts = allocation_counter::counts;
+    PhaseProfile& phase_profile{m_profile[phase]};
+    phase_profile.seconds += std::chrono::duration<double>(now - m_start).count();
+    phase_profile.allocations += counts.allocations - m_start_counts.allocations;
+    phase_profile.bytes += counts.bytes - m_start_counts.bytes;
+    m_start = now;
+    m_start_counts = counts;
+  }
+};
+
+} // namespace
+
+char const* phase_name(Phase phase)
+{
+  switch (phase)
+  {
+    case phase_parse:
+      return "parse";
+    case phase_opsem:
+      return "opsem";
+    case phase_post_opsem:
+      return "post_opsem";
+    case phase_rf_subgraphs:
+      return "rf_subgraphs";
+    case phase_unsequenced_races:
+      return "unsequenced_races";
+    case phase_rf_enumeration:
+      return "rf_enumeration";
+    case phase_loop_detection:
+      return "loop_detection";
+    case phase_output:
+      return "output";
+    case number_of_phases:
+      break;
+  }
+  return "unknown";
+}
+
+PhaseProfile Profile::total() const
+{
+  PhaseProfile total;
+  for (PhaseProfile const& phase_profile : phases)
+  {
+    total.seconds += phase_profile.seconds;
+    total.allocations += phase_profile.allocations;
+    total.bytes += phase_profile.bytes;
+  }
+  return total;
+}
+
+std::string alert_message(AIAlert::Error const& error)
+{
+  std::ostringstream oss;
+  for (auto&& line : error.lines())
+  {
+    if (line.prepend_newline()) oss << '\n';
+    oss << translate::getString(line.getXmlDesc(), line.args());
+  }
+  return oss.str();
+}
+
+namespace {
+
+// Return a * b, or the largest size_t if that overflows.
+size_t saturating_multiply(size_t a, size_t b)
+{
+  if (b != 0 && a > std::numeric_limits<size_t>::max() / b)
+    return std::numeric_limits<size_t>::max();
+  return a * b;
+}
+
+Result analyze_in_session(std::string_view source, Options const& options)
+{
+
+  Result result;
+  Profiler profiler(result.profile);
+
+  std::unique_ptr<Parser> own_parser;
+  Parser* parser = options.parser;
+  if (!parser)
+  {
+    own_parser.reset(new Parser);
+    parser = own_parser.get();
+  }
+
+  // All state of this analysis; freed again when we return.
+  AnalysisSession session(parser->symbols());
+
+  //==========================================================================
+  // Parse the source.
+
+  ast::cppmem ast;
+  iterator_type begin(source.data());
+  iterator_type const end(source.data() + source.size());
+  try
+  {
+    if (!parser->parse(options.filename, begin, end, ast))
+    {
+      result.error = "Parse error";
+      return result;
+    }
+  }
+  catch (std::exception const& error)
+  {
+    Dout(dc::warning, "Parser threw exception: " << error.what());
+  }
+
+  Graph& graph{session.graph()};
+  Context::instance().initialize(parser->get_position_handler(), graph);
+  profiler.lap(phase_parse);
+
+  if (options.observer)
+  {
+    options.observer->parsed(ast);
+    profiler.lap(phase_output);
+  }
+
+  if (options.compute_ast_hash)
+  {
+    result.ast_hash = normalized_ast_hash(ast);
+    if (options.observer && !options.observer->proceed(result.ast_hash))
+    {
+      result.success = result.stopped = true;
+      return result;
+    }
+  }
+
+  //==========================================================================
+  // Collect all global variables and their initialization, if any.
+
+  for (auto& node : ast)
+    if (node.which() == ast::DN_declaration_statement)
+    {
+      ast::declaration_statement& declaration_statement{boost::get<ast::declaration_statement>(node)};
+      execute_declaration(declaration_statement);
+    }
+
+  //==========================================================================
+  // Collect all function definitions.
+
+  ast::function const* main_function = nullptr;
+  for (auto& node : ast)
+    if (node.which() == ast::DN_function)
+    {
+      ast::function& function{boost::get<ast::function>(node)};
+      if (function.id == -1)
+      {
+        Dout(dc::warning, "function " << function << " has id -1 !?!");
+      }
+      session.functions()[function] = function;
+      //std::cout << "Function definition: " << function << std::endl;
+      if (function.m_function_name.name == "main")
+        main_function = &session.functions()[function];
+    }
+
+  //==========================================================================
+  // Generate Xopsem: all actions/nodes with all Sequenced-Before and
+  // Additionally-Synchronizes-With edges, as well as the Data- and Control-
+  // Dependency edges.
+
+  if (!main_function)
+  {
+    result.error = "No main() function";
+    return result;
+  }
+
+  try
+  {
+    // Execute main()
+    if (main_function->m_compound_statement.m_statement_seq)
+      execute_body("main", *main_function->m_compound_statement.m_statement_seq);
+  }
+  catch (AIAlert::Error const& error)
+  {
+    result.error = alert_message(error);
+    return result;
+  }
+  profiler.lap(phase_opsem);
+
+  //==========================================================================
+  // Brute force approach.
+
+#ifdef CWDEBUG
+  // Check that every node has a boolean product as exists condition.
+  FilterAllActions all_actions;
+  FollowUniqueOpsemTails follow_unique_opsem_tails;
+  graph.for_actions_no_condition(
+      follow_unique_opsem_tails,
+      all_actions,
+      [](Action* action)
+      {
+        Dout(dc::notice, "Testing " << *action);
+        ASSERT(action->exists().is_product());
+        return false;
+      }
+  );
+#endif
+
+  // Initialize m_sequence_number and m_sequenced_before of all Action nodes, and the index of all opsem edges.
+  TopologicalOrderedActions topological_ordered_actions;
+  int const number_of_opsem_edges = Action::initialize_post_opsem(graph, topological_ordered_actions);
+
+  profiler.lap(phase_post_opsem);
+
+  if (options.observer)
+  {
+    options.observer->opsem_ready(graph, topological_ordered_actions);
+    profiler.lap(phase_output);
+  }
+
+#if 0//def CWDEBUG
+  // Print out all sequenced-before results.
+  Debug(dc::for_action.off());
+  graph.for_actions_no_condition(
+      follow_unique_opsem_tails,
+      all_actions,
+      [&](Action* action1)
+      {
+        Dout(dc::notice, action1->name() << " -->");
+        graph.for_actions_no_condition(
+            follow_unique_opsem_tails,
+            all_actions,
+            [&](Action* action2)
+            {
+              if (action1->is_sequenced_before(*action2))
+                Dout(dc::notice|nolabel_cf|nonewline_cf, ' ' << action2->name());
+              return false;
+            }
+        );
+        Dout(dc::notice|nolabel_cf, "");
+        return false;
+      }
+  );
+  Debug(dc::for_action.on());
+#endif
+
+  // A vector of objects representing all read nodes per memory location.
+  utils::Vector<ReadFromLoopsPerLocation, RFLocation> read_from_loops_per_location_vector;
+  // A vector of objects representing all subgraphs per memory location.
+  utils::Vector<ReadFromLocationSubgraphs, RFLocation> read_from_location_subgraphs_vector;
+
+  // The visited state of the opsem edges, reused by every traversal.
+  VisitedEdges visited_edges(number_of_opsem_edges);
+
+  // Run over all memory locations.
+  for (auto&& location : Context::instance().locations())
+  {
+    Dout(dc::notice, "Considering location " << location);
+    read_from_loops_per_location_vector.emplace_back();
+    ReadFromLoopsPerLocation& read_from_loops_per_location(read_from_loops_per_location_vector.back());
+    read_from_location_subgraphs_vector.emplace_back(location);
+    ReadFromLocationSubgraphs& read_from_location_subgraph(read_from_location_subgraphs_vector.back());
+
+    // Find all read actions for this location in topological order (their m_sequence_number).
+    // Also reset the visited flags.
+    for (Action* action : topological_ordered_actions)
+    {
+      if (action->location() == location && action->is_read())
+      {
+        Dout(dc::notice, "Found read " << *action);
+        read_from_loops_per_location.add_read_action(action, topological_ordered_actions);
+      }
+      if (action->location() == location && action->is_write())
+        read_from_location_subgraph.add_write_action(action);
+    }
+
+    bool new_writes_found = false;
+    //int rf_candidate = 0;
+    size_t number_of_read_actions = read_from_loops_per_location.number_of_read_actions();
+    Dout(dc::notice, "Number of read actions: " << number_of_read_actions);
+    if (number_of_read_actions == 0)
+    {
+      read_from_loops_per_location_vector.pop_back();
+      read_from_location_subgraphs_vector.pop_back();
+      continue;
+    }
+    for (MultiLoop ml(number_of_read_actions); !ml.finished(); ml.next_loop())
+      for (;;)
+      {
+        ReadFromLoop& read_from_loop{read_from_loops_per_location[*ml]};
+
+        // Each read_from_loop basically has the following structure:
+        //
+        // begin();
+        // while (find_next_write_action())
+        // {
+        //   add_edge();
+        //   ... <next for loop or inner loop body>...
+        //   delete_edge();
+        // }
+        //
+        // Hence find_next_write_action() finds the first write action that we read from
+        // when begin() was just called, otherwise advances to the next iteration, and
+        // returns false when there are no write action (left).
+
+        if (ml() == 0)                          // If we just entered this loop, call begin().
+          read_from_loop.begin();
+        else
+          read_from_loop.delete_edge(read_from_loops_per_location);     // Otherwise remove the edge that was added the previous loop.
+
+        if (!read_from_loop.find_next_write_action(read_from_loops_per_location, visited_edges))
+          break;
+
+        if (read_from_loop.add_edge(read_from_loops_per_location))
+          new_writes_found = true;
+
+        if (ml.inner_loop())
+        {
+          if (new_writes_found)
+          {
+            new_writes_found = false;
+
+            // Calculate under which condition this graph is valid.
+            // The graph is valid when every read has a read-from edge when it exists.
+            boolean::Expression valid{true};
+            for (unsigned int read_loop = 0; read_loop < number_of_read_actions; ++read_loop)
+            {
+              ReadFromLoop& read_from_loop{read_from_loops_per_location[read_loop]};
+              valid = valid.times(read_from_loop.have_write()(boolean::TruthProduct{read_from_loop.have_read().as_product()}));
+            }
+            //graph.write_png_file(basename + "_" + location.name() + "_rf", topological_ordered_actions, valid, rf_candidate++);
+
+            // Collect all ReadFromSubgraphs, except those that violate coherence.
+            // Because all rf edges of a subgraph are of the same location, that can be checked here, once,
+            // instead of every time that the subgraph is pushed onto the ReadFromGraph.
+            if (!read_from_location_subgraph.add(DirectedSubgraph{graph, edge_mask_rf, edge_mask_rf, std::move(valid)}))
+              stats::increment(stats::coherence_rejected_subgraphs);
+          }
+        }
+
+        ml.start_next_loop_at(0);
+      }
+  }
+
+  profiler.lap(phase_rf_subgraphs);
+
+  // Find all Unsequenced-Race edges.
+  for (Action* action : topological_ordered_actions)
+  {
+    if (action->is_write())                                     // At least one must be a write.
+    {
+      bool const is_atomic_write{action->is_atomic()};
+      Location const& location{action->location()};
+      for (Action* action2 : topological_ordered_actions)
+      {
+        if (action2->thread() == action->thread() &&            // Both actions must be part of the same thread.
+            (!action2->is_write() || action2 < action) &&       // Do not generate the same edge twice, or an edge between the same write action.
+            (!is_atomic_write || !action2->is_atomic()) &&      // At least one must be non-atomic.
+            action2->location() == location &&                  // Both actions must involve the same memory location.
+            !action2->is_sequenced_before(*action) &&           // The two actions must be unsequenced.
+            !action->is_sequenced_before(*action2))
+        {
+          Dout(dc::notice, "Unsequenced-Race between " << *action << " and " << *action2 << "!");
+          action->add_edge_to(edge_ur, action2);
+          result.unsequenced_races.emplace_back(action->sequence_number().get_value(), action2->sequence_number().get_value());
+        }
+      }
+      Dout(dc::notice, *action);
+    }
+  }
+
+  // The combinations of rf subgraphs that contain an incoherent subgraph are never enumerated.
+  size_t all_combinations = 1;
+  size_t coherent_combinations = 1;
+  for (ReadFromLocationSubgraphs const& read_from_location_subgraphs : read_from_location_subgraphs_vector)
+  {
+    result.statistics.rf_subgraphs += read_from_location_subgraphs.size();
+    all_combinations = saturating_multiply(all_combinations, read_from_location_subgraphs.size() + read_from_location_subgraphs.incoherent());
+    coherent_combinations = saturating_multiply(coherent_combinations, read_from_location_subgraphs.size());
+  }
+  // If the number of combinations doesn't fit in a size_t, then report the maximum.
+  result.statistics.coherence_rejected =
+      all_combinations == std::numeric_limits<size_t>::max() ? all_combinations : all_combinations - coherent_combinations;
+  stats::add(stats::coherence_rejected, result.statistics.coherence_rejected);
+
+  profiler.lap(phase_unsequenced_races);
+
+  // From here on only witness edges are added to (and removed from) the graph.
+  if (options.observer)
+  {
+    options.observer->witnesses_start(graph, topological_ordered_actions, read_from_location_subgraphs_vector, result.unsequenced_races);
+    profiler.lap(phase_output);
+  }
+
+  size_t number_of_locations_with_rf = read_from_location_subgraphs_vector.size();      // The number of memory locations that have at least one read-from edge.
+  Dout(dc::notice, "Number of locations with at least one rf edge: " << number_of_locations_with_rf);
+
+  // Partition the locations into clusters whose rf subgraphs can be chosen independently of each other.
+  LocationClusters location_clusters{topological_ordered_actions, read_from_location_subgraphs_vector};
+  if (!options.cluster_locations)
+    location_clusters.merge();
+  if (options.location_order == location_order_heuristic)
+    location_clusters.order_most_constrained_first(topological_ordered_actions, read_from_location_subgraphs_vector);
+  {
+    std::ostringstream oss;
+    location_clusters.print_on(oss, read_from_location_subgraphs_vector);
+    result.location_order = oss.str();
+  }
+  Dout(dc::notice, "Number of independent location clusters: " << location_clusters.size() << "; location order: " << result.location_order);
+  result.statistics.location_clusters = location_clusters.size();
+  stats::add(stats::location_clusters, location_clusters.size());
+
+  // A consistent combination of rf subgraphs of the locations of one cluster.
+  struct ClusterCombination
+  {
+    std::vector<int> m_subgraphs;               // The index of the chosen subgraph of each location of the cluster.
+    boolean::Expression m_valid;                // The condition under which this combination is valid (including that there is no loop).
+    boolean::Expression m_loop_condition;       // The condition under which this combination contains a loop.
+  };
+  std::vector<std::vector<ClusterCombination>> cluster_combinations(location_clusters.size());
+
+  // Generate all Read-From edges, for each cluster separately.
+  for (size_t cluster_index = 0; cluster_index < location_clusters.size(); ++cluster_index)
+  {
+    LocationClusters::cluster_type const& cluster{location_clusters[cluster_index]};
+    ReadFromGraph read_from_graph{graph, edge_mask_sbw, edge_mask_none, topological_ordered_actions, read_from_location_subgraphs_vector, cluster};
+    // A single location can only have a loop together with the subgraph of another location.
+    // If that other location is in a different cluster, the loop can only involve the rf edges
+    // of this location, so look for it anyway in order to find the same loops as without clustering.
+    bool const detect_single_location_loops = cluster.size() == 1 && number_of_locations_with_rf > 1;
+
+    for (MultiLoop ml(cluster.size()); !ml.finished(); ml.next_loop())
+    {
+      for (;;)
+      {
+        ReadFromLocationSubgraphs& read_from_location_subgraphs{read_from_location_subgraphs_vector[cluster[*ml]]};
+        if (ml() == (int)read_from_location_subgraphs.size())
+          break;
+        // Begin of loop *ml.
+        read_from_graph.push(read_from_location_subgraphs[ml()]);
+        if (*ml > 0 || detect_single_location_loops)    // We need at least two read-from subgraphs before there can be a loop.
+        {
+#ifdef CWDEBUG
+          static int count = 0;
+          ++count;
+          Dout(dc::notice|continued_cf, "Calling loop_detected() with *ml == " << *ml << "; count = " << count << "; ml = ");
+          for (unsigned int j = 0; j <= *ml; ++j)
+            Dout(dc::continued, (j > 0 ? ", " : "") << ml[j]);
+          Dout(dc::finish, "");
+#endif
+          profiler.lap(phase_rf_enumeration);
+          bool const loop_detected = read_from_graph.loop_detected().is_one();
+          profiler.lap(phase_loop_detection);
+          if (loop_detected)
+          {
+            Dout(dc::notice, " loop_detected() with *ml == " << *ml << " returned true! Continuing the current loop!");
+#if 0   // Remove this in order to print also fully rejected graphs.
+            read_from_graph.pop();
+            ml.breaks(0);
+            break;
+#endif
+          }
+        }
+        if (ml.inner_loop())
+        {
+          // Calculate under which condition this combination is valid.
+          boolean::Expression valid{true};
+          for (unsigned int i = 0; i < cluster.size(); ++i)
+            valid = valid.times(read_from_location_subgraphs_vector[cluster[i]][ml[i]].valid());
+          valid = valid.times(read_from_graph.loop_condition().inverse());
+          ++result.statistics.rf_combinations;
+          stats::increment(stats::rf_combinations);
+          if (valid.is_zero())
+          {
+            // Count the combinations that were rejected while a loop was detected.
+            if (!read_from_graph.loop_condition().is_zero())
+              stats::increment(stats::loop_rejected);
+          }
+          else
+          {
+            ClusterCombination combination{std::vector<int>(cluster.size()), std::move(valid), read_from_graph.loop_condition().copy()};
+            for (unsigned int i = 0; i < cluster.size(); ++i)
+              combination.m_subgraphs[i] = ml[i];
+            cluster_combinations[cluster_index].push_back(std::move(combination));
+          }
+          read_from_graph.pop();
+        }
+        ml.start_next_loop_at(0);
+      }
+      if (ml.end_of_loop() >= 0)
+        read_from_graph.pop();
+    }
+  }
+
+  // Every candidate is one consistent combination of each cluster.
+  size_t number_of_candidates = 0;
+  size_t number_of_distinct_graphs = 0;
+
+  // If at most one cluster has combinations whose validity is conditional (so that no product
+  // of combinations can be invalid), then both counts are a product over the clusters: the rf
+  // edges of different clusters belong to different locations, hence two candidates are the
+  // same graph if and only if they are the same graph in every cluster.
+  size_t number_of_conditional_clusters = 0;
+  for (std::vector<ClusterCombination> const& combinations : cluster_combinations)
+    if (std::any_of(combinations.begin(), combinations.end(), [](ClusterCombination const& combination){ return !combination.m_valid.is_one(); }))
+      ++number_of_conditional_clusters;
+  bool const count_as_product = number_of_conditional_clusters <= 1 && location_clusters.size() > 0;
+  // The observer, if it wants to see every candidate.
+  AnalysisObserver* const candidate_observer = options.observer && options.observer->wants_candidates() ? options.observer : nullptr;
+  // The cross product of the combinations of all clusters is only enumerated when somebody consumes the individual candidates,
+  // or when the counts can't be calculated as a product.
+  bool const need_candidates = candidate_observer || options.collect_executions;
+
+  if (count_as_product)
+  {
+    number_of_candidates = number_of_distinct_graphs = 1;
+    for (size_t cluster_index = 0; cluster_index < location_clusters.size(); ++cluster_index)
+    {
+      LocationClusters::cluster_type const& cluster{location_clusters[cluster_index]};
+      std::vector<ClusterCombination> const& combinations{cluster_combinations[cluster_index]};
+      CandidateDeduplicator cluster_deduplicator;
+      for (size_t index = 0; index < combinations.size(); ++index)
+      {
+        cluster_deduplicator.begin_candidate();
+        for (unsigned int i = 0; i < cluster.size(); ++i)
+          cluster_deduplicator.add_rf_edges(read_from_location_subgraphs_vector[cluster[i]][combinations[index].m_subgraphs[i]]);
+        cluster_deduplicator.end_candidate(index, combinations[index].m_valid);
+      }
+      number_of_candidates = saturating_multiply(number_of_candidates, combinations.size());
+      number_of_distinct_graphs = saturating_multiply(number_of_distinct_graphs, cluster_deduplicator.graphs().size());
+    }
+    stats::add(stats::rf_candidates, number_of_candidates);
+  }
+  if (need_candidates || !count_as_product)
+  {
+    CandidateDeduplicator deduplicator;
+    int rf_candidate = 0;
+    RFLocationSubgraphIndices subgraph_indices(number_of_locations_with_rf);
+
+    for (MultiLoop ml(location_clusters.size()); !ml.finished(); ml.next_loop())
+    {
+      for (;;)
+      {
+        if (ml() == (int)cluster_combinations[*ml].size())
+          break;
+        if (ml.inner_loop())
+        {
+          // The combinations of different clusters can still be mutually exclusive through their conditions.
+          boolean::Expression valid{true};
+          boolean::Expression loop_condition{false};
+          for (unsigned int c = 0; c < location_clusters.size(); ++c)
+          {
+            ClusterCombination const& combination{cluster_combinations[c][ml[c]]};
+            valid = valid.times(combination.m_valid);
+            loop_condition += combination.m_loop_condition;
+            for (unsigned int i = 0; i < location_clusters[c].size(); ++i)
+              subgraph_indices[location_clusters[c][i]] = combination.m_subgraphs[i];
+          }
+          if (!valid.is_zero())
+          {
+            if (!count_as_product)
+              stats::increment(stats::rf_candidates);
+            // Construct a new graph, but only if the observer needs it.
+            if (candidate_observer)
+              graph.delete_edges(edge_rf);
+            Execution execution;
+            execution.candidate = rf_candidate++;
+            // Detect candidates that result in the same graph as an earlier candidate.
+            deduplicator.begin_candidate();
+            for (RFLocation location = read_from_location_subgraphs_vector.ibegin(); location != read_from_location_subgraphs_vector.iend(); ++location)
+            {
+              DirectedSubgraph const& read_from_location_subgraph{read_from_location_subgraphs_vector[location][subgraph_indices[location]]};
+              if (candidate_observer)
+                read_from_location_subgraph.add_to(graph);
+              deduplicator.add_rf_edges(read_from_location_subgraph);
+              if (need_candidates)
+                for (DirectedEdge const& directed_edge : read_from_location_subgraph)
+                  execution.rf.emplace_back(directed_edge.tail_sequence_number().get_value(), directed_edge.head_sequence_number().get_value());
+            }
+            execution.same_as = deduplicator.end_candidate(execution.candidate, valid);
+            if (need_candidates)
+            {
+              std::ostringstream oss;
+              oss << valid;
+              execution.valid = oss.str();
+              oss.str(std::string());
+              oss << loop_condition;
+              execution.loop = oss.str();
+            }
+            if (candidate_observer)
+            {
+              profiler.lap(phase_rf_enumeration);
+              candidate_observer->candidate(graph, execution, subgraph_indices, valid, loop_condition);
+              profiler.lap(phase_output);
+            }
+            if (options.collect_executions)
+              result.executions.push_back(std::move(execution));
+          }
+        }
+        ml.start_next_loop_at(0);
+      }
+    }
+    // Both ways of counting must agree.
+    ASSERT(!count_as_product || (number_of_candidates == static_cast<size_t>(rf_candidate) && number_of_distinct_graphs == deduplicator.graphs().size()));
+    number_of_candidates = rf_candidate;
+    number_of_distinct_graphs = deduplicator.graphs().size();
+  }
+
+  profiler.lap(phase_rf_enumeration);
+
+  result.statistics.candidates = number_of_candidates;
+  result.statistics.distinct_graphs = number_of_distinct_graphs;
+
+  // Run over all possible flow-control paths.
+  conditionals_type const& conditionals{Context::instance().conditionals()};
+  int number_of_boolean_expressions = conditionals.size();
+  using mask_type = boolean::Expression::mask_type;
+  mask_type permutations_end = (mask_type)1 << number_of_boolean_expressions;
+  Dout(dc::notice, "There " << (permutations_end == 1 ? "is " : "are ") <<
+      permutations_end << " flow-control path permutation" << (permutations_end == 1 ? "" : "s") << ".");
+  for (mask_type permutation = 0; permutation < permutations_end; ++permutation)
+  {
+
+  }
+
+  result.statistics.actions = topological_ordered_actions.size();
+  result.statistics.locations = Context::instance().locations().size();
+  result.statistics.locations_with_rf = number_of_locations_with_rf;
+  result.success = true;
+  return result;
+}
+
+} // namespace
+
+Result analyze(std::string_view source, Options const& options)
+{
+  DoutEntering(dc::notice, "cppmem::analyze(\"" << options.filename << "\")");
+
+  try
+  {
+    return analyze_in_session(source, options);
+  }
+  catch (AIAlert::Error const& error)
+  {
+    // For example, because the test needs more boolean variables than there are (see BooleanVariables).
+    Result result;
+    result.error = alert_message(error);
+    return result;
+  }
+}
+
+std::string normalized_ast_hash(ast::cppmem const& ast)
+{
+  std::ostringstream oss;
+  {
+    ast::CanonicalNames canonical_names;
+    oss << ast;
+  }
+  fnv1a::hash_type hash = fnv1a::offset_basis;
+  fnv1a::add(hash, oss.str());
+  return fnv1a::to_string(hash);
+}
+
+} // namespace cppmem
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "debug.h"
+#include "TopologicalOrderedActions.h"
+#include "RFLocationOrderedSubgraphs.h"
+#include "boolean-expression/BooleanExpression.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ast {
+struct cppmem;
+} // namespace ast
+
+namespace AIAlert {
+class Error;
+} // namespace AIAlert
+
+class Graph;
+class ReadFromLocationSubgraphs;
+
+namespace cppmem {
+
+class Parser;
+
+// An rf edge (write, read), using the sequence numbers of the Action nodes.
+using RFEdge = std::pair<int, int>;
+
+// An unsequenced race between two actions (write, other), using the sequence numbers of the Action nodes.
+using UnsequencedRace = std::pair<int, int>;
+
+// A consistent execution (rf candidate).
+struct Execution
+{
+  int candidate;                        // The candidate number.
+  int same_as;                          // The first candidate with the same graph; equal to candidate if this is a distinct graph.
+  std::vector<RFEdge> rf;               // All rf edges.
+  std::string valid;                    // The condition under which this execution is valid.
+  std::string loop;                     // The condition under which the rf edges (together with sb and asw) contain a loop.
+};
+
+struct Statistics
+{
+  size_t actions = 0;                   // The number of Action nodes.
+  size_t locations = 0;                 // The number of memory locations.
+  size_t locations_with_rf = 0;         // The number of memory locations that have at least one read.
+  size_t rf_subgraphs = 0;              // The total number of rf subgraphs (of all locations).
+  size_t location_clusters = 0;         // The number of independent clusters of locations (see LocationClusters).
+  size_t rf_combinations = 0;           // The number of combinations of rf subgraphs that were considered (summed over all clusters).
+  size_t coherence_rejected = 0;        // The number of combinations of rf subgraphs that were rejected by the coherence pre-check, without being considered (saturates at SIZE_MAX).
+  size_t candidates = 0;                // The number of consistent rf candidates.
+  size_t distinct_graphs = 0;           // The number of distinct graphs among those candidates.
+};
+
+// The phases of analyze().
+enum Phase
+{
+  phase_parse,                          // Parsing the source.
+  phase_opsem,                          // Executing the global declarations and main(): generating all actions with their sb and asw edges.
+  phase_post_opsem,                     // Action::initialize_post_opsem: the topological ordering and the sequenced-before relation.
+  phase_rf_subgraphs,                   // Enumerating the ReadFromLoop's of every location, collecting all rf subgraphs.
+  phase_unsequenced_races,              // Finding the unsequenced races.
+  phase_rf_enumeration,                 // Enumerating all combinations of rf subgraphs (the ReadFromGraph MultiLoop), except for the loop detection.
+  phase_loop_detection,                 // Detecting loops in those combinations.
+  phase_output,                         // Time spent in the AnalysisObserver.
+  number_of_phases
+};
+
+// Return the (JSON friendly) name of phase.
+char const* phase_name(Phase phase);
+
+// The resources used by one phase.
+struct PhaseProfile
+{
+  double seconds = 0;                   // Wall-clock time (measured with a monotonic clock).
+  uint64_t allocations = 0;             // The number of calls to operator new (only if Profile::allocations_counted).
+  uint64_t bytes = 0;                   // The number of bytes allocated with operator new (only if Profile::allocations_counted).
+};
+
+// The resources used by each phase of analyze().
+struct Profile
+{
+  PhaseProfile phases[number_of_phases];
+  bool allocations_counted = false;     // Set if the program counts allocations (see AllocationCounter.h); otherwise allocations and bytes are zero.
+
+  PhaseProfile& operator[](Phase phase) { return phases[phase]; }
+  PhaseProfile const& operator[](Phase phase) const { return phases[phase]; }
+
+  // Return the sum over all phases.
+  PhaseProfile total() const;
+};
+
+// The result of analyze().
+struct Result
+{
+  bool success = false;                                 // Set if the analysis completed.
+  bool stopped = false;                                 // Set if the observer stopped the analysis after parsing (see AnalysisObserver::proceed).
+  std::string error;                                    // The error when success is false.
+  std::string ast_hash;                                 // The normalized AST hash, if Options::compute_ast_hash is set.
+  std::vector<Execution> executions;                    // All consistent executions, if Options::collect_executions is set.
+  std::vector<UnsequencedRace> unsequenced_races;       // All unsequenced races.
+  std::string location_order;                           // The order in which the rf subgraphs of the locations are enumerated, per cluster; for example "{flag data} {y}".
+  Statistics statistics;
+  Profile profile;
+};
+
+// Hooks into the different stages of analyze(), for callers that need access to the graph itself.
+// All member functions do nothing by default.
+//
+class AnalysisObserver
+{
+ public:
+  virtual ~AnalysisObserver() = default;
+
+  // Called directly after parsing.
+  virtual void parsed(ast::cppmem const& UNUSED_ARG(ast)) { }
+
+  // Called after parsing when Options::compute_ast_hash is set. Return false to stop the analysis (for example, because the result is cached).
+  virtual bool proceed(std::string const& UNUSED_ARG(ast_hash)) { return true; }
+
+  // Called once the opsem graph (the sb and asw edges) is complete.
+  virtual void opsem_ready(Graph& UNUSED_ARG(graph), TopologicalOrderedActions const& UNUSED_ARG(topological_ordered_actions)) { }
+
+  // Called before enumerating the rf candidates, after all non-witness edges were added to graph.
+  virtual void witnesses_start(Graph& UNUSED_ARG(graph), TopologicalOrderedActions const& UNUSED_ARG(topological_ordered_actions),
+      utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& UNUSED_ARG(read_from_location_subgraphs_vector),
+      std::vector<UnsequencedRace> const& UNUSED_ARG(unsequenced_races)) { }
+
+  // Return false if candidate() doesn't need to be called (see Options::collect_executions).
+  virtual bool wants_candidates() const { return true; }
+
+  // Called for every consistent candidate, while graph contains its rf edges.
+  // The index of the rf subgraph of every location is given by subgraph_indices.
+  virtual void candidate(Graph& UNUSED_ARG(graph), Execution const& UNUSED_ARG(execution), RFLocationSubgraphIndices const& UNUSED_ARG(subgraph_indices),
+      boolean::Expression const& UNUSED_ARG(valid), boolean::Expression const& UNUSED_ARG(loop_condition)) { }
+};
+
+// The order in which the rf subgraphs of the locations of a cluster are enumerated (the first location is the outer loop).
+enum LocationOrder
+{
+  location_order_heuristic,                     // Most constrained first (see LocationClusters::order_most_constrained_first).
+  location_order_declaration                    // The order in which the locations were declared.
+};
+
+// Every candidate is a combination of one consistent rf combination of every cluster of
+// locations (see LocationClusters). The cross product of those is only enumerated when
+// collect_executions is set or the observer wants the candidates (see
+// AnalysisObserver::wants_candidates), or when the combinations of more than one cluster
+// are only valid under some condition. Otherwise the number of candidates and of distinct
+// graphs are calculated as a product over the clusters.
+struct Options
+{
+  char const* filename = "<input>";             // The name of the source, used in diagnostics.
+  bool collect_executions = true;               // Store every consistent execution in Result::executions.
+  AnalysisObserver* observer = nullptr;         // Optional hooks.
+  Parser* parser = nullptr;                     // Reuse this parser, if set; otherwise a new parser is constructed.
+  bool compute_ast_hash = false;                // Calculate Result::ast_hash.
+  LocationOrder location_order = location_order_heuristic;      // The order of the locations in the rf enumeration (for benchmarking).
+  bool cluster_locations = true;                                // Enumerate the rf subgraphs of independent clusters of locations separately (see LocationClusters).
+};
+
+// Analyze the program in source.
+//
+// The analysis runs in its own AnalysisSession and does not do any file I/O.
+// Pass the same Options::parser to subsequent calls to avoid constructing
+// the grammar again for every source.
+//
+Result analyze(std::string_view source, Options const& options = Options());
+
+// Return the (translated) text of error, as used for Result::error.
+std::string alert_message(AIAlert::Error const& error);
+
+// Return a hash of ast as 32 hexadecimal digits.
+//
+// The hash is calculated over the printed AST, hence it does not depend on
+// white space or comments. Variables and registers are printed with canonical
+// names (see ast::CanonicalNames), so tests that only differ in the names
+// they use have the same hash.
+//
+std::string normalized_ast_hash(ast::cppmem const& ast);
+
+} // namespace cppmem
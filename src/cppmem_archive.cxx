@@ -0,0 +1,78 @@
+#include "sys.h"
+#include "debug.h"
+#include "ResultsArchiveReader.h"
+#include "utils/AIAlert.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+// Inspect a results archive, as written by `cppmem --archive <archive file>'.
+//
+// Without candidate, list all candidates in the archive.
+// With `subgraphs', list the rf subgraphs of every location with the condition under which they are valid.
+// Otherwise, write the graph of the given candidate in dot format to stdout.
+//
+int main(int argc, char* argv[])
+{
+  Debug(NAMESPACE_DEBUG::init());
+
+  if (argc != 2 && argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <archive file> [<candidate>|subgraphs]\n";
+    return 1;
+  }
+
+  try
+  {
+    ResultsArchiveReader archive(argv[1]);
+
+    if (argc == 2)
+    {
+      for (size_t index = 0; index < archive.number_of_candidates(); ++index)
+      {
+        results_archive::CandidateRecord const& record{archive.record(index)};
+        std::cout << record.m_candidate << ':';
+        for (size_t location = 0; location < archive.number_of_locations(); ++location)
+          std::cout << ' ' << archive.subgraph_index(index, location);
+        if ((record.m_flags & results_archive::candidate_duplicate))
+          std::cout << " duplicate";
+        if ((record.m_flags & results_archive::candidate_unsequenced_races))
+          std::cout << " unsequenced-races";
+        if ((record.m_flags & results_archive::candidate_loop))
+          std::cout << " loop";
+        std::cout << '\n';
+      }
+      return 0;
+    }
+
+    if (std::string(argv[2]) == "subgraphs")
+    {
+      for (size_t location = 0; location < archive.number_of_locations(); ++location)
+        for (size_t subgraph = 0; subgraph < archive.number_of_subgraphs(location); ++subgraph)
+        {
+          std::string const valid = archive.subgraph_valid(location, subgraph);
+          std::cout << location << ' ' << subgraph << ": " << (valid.empty() ? "1" : valid) << '\n';
+        }
+      return 0;
+    }
+
+    uint32_t const candidate = std::atoi(argv[2]);
+    for (size_t index = 0; index < archive.number_of_candidates(); ++index)
+      if (archive.record(index).m_candidate == candidate)
+      {
+        archive.write_dot(std::cout, index);
+        return 0;
+      }
+    std::cerr << "No candidate " << candidate << " in \"" << argv[1] << "\".\n";
+  }
+  catch (AIAlert::Error const& error)
+  {
+    for (auto&& line : error.lines())
+    {
+      if (line.prepend_newline()) std::cerr << std::endl;
+      std::cerr << translate::getString(line.getXmlDesc(), line.args());
+    }
+    std::cerr << '.' << std::endl;
+  }
+  return 1;
+}
@@ -0,0 +1,205 @@
+#include "sys.h"
+#include "debug.h"
+#include "cppmem_analyzer.h"
+#include "cppmem_parser.h"
+#include "ReadFromLocationSubgraphs.h"
+#include "NDJSONWriter.h"
+#include "SourceFile.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// Time the analysis of a corpus of tests (make bench).
+//
+// Every test is analyzed `runs' times (after one warm-up run) and the mean
+// time spent in each phase (see cppmem::Profile) is reported, together
+// with the mean and minimum total time and the number of allocations and
+// bytes allocated per run (n/a, or left out, when they are not counted),
+// as CSV (the default) or as one JSON record per test.
+// The order in which the locations were enumerated is reported as well; use
+// --location-order declaration to compare with the unordered enumeration.
+//
+// The output phase writes an NDJSON record for every distinct candidate
+// to memory, so that it measures the cost of formatting the results
+// without the noise of disk I/O. With --count-only there is no output
+// phase, and the candidates are only counted (see cppmem::Options).
+
+namespace {
+
+// Format every distinct candidate as NDJSON, in memory.
+class BenchObserver : public cppmem::AnalysisObserver
+{
+ private:
+  std::ostringstream m_output;
+  NDJSONWriter m_ndjson_writer;
+  utils::Vector<ReadFromLocationSubgraphs, RFLocation> const* m_read_from_location_subgraphs_vector = nullptr;
+  bool m_have_unsequenced_races = false;
+
+ public:
+  BenchObserver() : m_ndjson_writer(m_output) { }
+
+  void witnesses_start(Graph& UNUSED_ARG(graph), TopologicalOrderedActions const& UNUSED_ARG(topological_ordered_actions),
+      utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector,
+      std::vector<cppmem::UnsequencedRace> const& unsequenced_races) override
+  {
+    m_output.str(std::string());
+    m_read_from_location_subgraphs_vector = &read_from_location_subgraphs_vector;
+    m_have_unsequenced_races = !unsequenced_races.empty();
+  }
+
+  void candidate(Graph& UNUSED_ARG(graph), cppmem::Execution const& execution, RFLocationSubgraphIndices const& subgraph_indices,
+      boolean::Expression const& valid, boolean::Expression const& loop_condition) override
+  {
+    if (execution.same_as != execution.candidate)
+      return;
+    utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector{*m_read_from_location_subgraphs_vector};
+    m_ndjson_writer.begin_candidate(execution.candidate);
+    for (RFLocation location = read_from_location_subgraphs_vector.ibegin(); location != read_from_location_subgraphs_vector.iend(); ++location)
+      m_ndjson_writer.add_rf_edges(read_from_location_subgraphs_vector[location][subgraph_indices[location]]);
+    m_ndjson_writer.end_candidate(valid, loop_condition, m_have_unsequenced_races);
+  }
+};
+
+int constexpr number_of_phases = cppmem::number_of_phases;
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Debug(NAMESPACE_DEBUG::init());
+
+  int runs = 10;
+  bool json = false;
+  cppmem::LocationOrder location_order = cppmem::location_order_heuristic;
+  bool count_only = false;
+  std::vector<char const*> filepaths;
+  bool usage_error = false;
+  for (int arg = 1; arg < argc && !usage_error; ++arg)
+  {
+    std::string const argument{argv[arg]};
+    if (argument == "--runs" && arg + 1 < argc)
+    {
+      runs = std::atoi(argv[++arg]);
+      usage_error = runs <= 0;
+    }
+    else if (argument == "--format" && arg + 1 < argc)
+    {
+      std::string const format{argv[++arg]};
+      json = format == "json";
+      usage_error = !json && format != "csv";
+    }
+    else if (argument == "--count-only")
+      count_only = true;
+    else if (argument == "--location-order" && arg + 1 < argc)
+    {
+      std::string const order{argv[++arg]};
+      if (order == "declaration")
+        location_order = cppmem::location_order_declaration;
+      else
+        usage_error = order != "heuristic";
+    }
+    else if (argument[0] != '-')
+      filepaths.push_back(argv[arg]);
+    else
+      usage_error = true;
+  }
+  if (usage_error || filepaths.empty())
+  {
+    std::cerr << "Usage: " << argv[0] << " [--runs <N>] [--format csv|json] [--location-order heuristic|declaration] [--count-only] <input file>...\n";
+    return 1;
+  }
+
+  if (!json)
+  {
+    std::cout << "test,runs,candidates,distinct";
+    for (int phase = 0; phase < number_of_phases; ++phase)
+      std::cout << ',' << cppmem::phase_name(static_cast<cppmem::Phase>(phase));
+    std::cout << ",total,min_total,allocations,bytes,location_order\n";
+  }
+  std::cout << std::setprecision(6);
+
+  cppmem::Parser parser;
+  BenchObserver observer;
+  cppmem::Options options;
+  options.collect_executions = false;
+  options.observer = count_only ? nullptr : &observer;
+  options.parser = &parser;
+  options.location_order = location_order;
+  int failures = 0;
+  for (char const* filepath : filepaths)
+  {
+    SourceFile source_file(filepath);
+    if (!source_file.is_open())
+    {
+      std::cerr << "Failed to open input file \"" << filepath << "\".\n";
+      ++failures;
+      continue;
+    }
+    options.filename = filepath;
+
+    // Warm up.
+    cppmem::Result result = cppmem::analyze(source_file.view(), options);
+    if (!result.success)
+    {
+      std::cerr << filepath << ": " << result.error << '.' << std::endl;
+      ++failures;
+      continue;
+    }
+
+    double totals[number_of_phases] = {};
+    double min_total = 0;
+    for (int run = 0; run < runs; ++run)
+    {
+      result = cppmem::analyze(source_file.view(), options);
+      double total = 0;
+      for (int phase = 0; phase < number_of_phases; ++phase)
+      {
+        double const seconds = result.profile.phases[phase].seconds;
+        totals[phase] += seconds;
+        total += seconds;
+      }
+      if (run == 0 || total < min_total)
+        min_total = total;
+    }
+
+    // The allocations are the same for every run; report those of the last run.
+    cppmem::PhaseProfile const allocated = result.profile.total();
+    double total = 0;
+    for (double& phase_total : totals)
+    {
+      phase_total /= runs;
+      total += phase_total;
+    }
+    if (json)
+    {
+      std::cout << "{\"test\":";
+      NDJSONWriter::write_json_string(std::cout, filepath);
+      std::cout << ",\"runs\":" << runs <<
+          ",\"candidates\":" << result.statistics.candidates << ",\"distinct\":" << result.statistics.distinct_graphs;
+      for (int phase = 0; phase < number_of_phases; ++phase)
+        std::cout << ",\"" << cppmem::phase_name(static_cast<cppmem::Phase>(phase)) << "\":" << totals[phase];
+      std::cout << ",\"total\":" << total << ",\"min_total\":" << min_total;
+      if (result.profile.allocations_counted)
+        std::cout << ",\"allocations\":" << allocated.allocations << ",\"bytes\":" << allocated.bytes;
+      std::cout << ",\"location_order\":";
+      NDJSONWriter::write_json_string(std::cout, result.location_order);
+      std::cout << "}\n";
+    }
+    else
+    {
+      std::cout << filepath << ',' << runs << ',' << result.statistics.candidates << ',' << result.statistics.distinct_graphs;
+      for (double phase_total : totals)
+        std::cout << ',' << phase_total;
+      std::cout << ',' << total << ',' << min_total << ',';
+      if (result.profile.allocations_counted)
+        std::cout << allocated.allocations << ',' << allocated.bytes;
+      else
+        std::cout << "n/a,n/a";
+      std::cout << ',' << result.location_order << '\n';
+    }
+  }
+  return failures > 0 ? 1 : 0;
+}
@@ -1,15 +1,14 @@
 #include "sys.h"
 #include "cppmem_parser.h"
 #include "grammar_cppmem.h"
+#include "AnalysisSession.h"
 
 namespace cppmem {
 
-bool parse(iterator_type& begin, iterator_type const& end, position_handler<iterator_type>& handler, ast::cppmem& out)
-{
-  using namespace parser;
+namespace {
 
-  skipper<iterator_type> skipper;
-  bool r = qi::phrase_parse(begin, end, grammar_cppmem<iterator_type>(handler), skipper, out);
+bool check_parse_result(bool r, iterator_type const& begin, iterator_type const& end)
+{
   if (!r)
   {
     std::cerr << "Parse error." << std::endl;
@@ -23,4 +22,40 @@ bool parse(iterator_type& begin, iterator_type const& end, position_handler<iter
   return true;
 }
 
+} // namespace
+
+bool parse(iterator_type& begin, iterator_type const& end, position_handler<iterator_type>& handler, ast::cppmem& out)
+{
+  using namespace parser;
+
+  skipper<iterator_type> skipper;
+  bool r = qi::phrase_parse(begin, end, grammar_cppmem<iterator_type>(handler), skipper, out);
+  return check_parse_result(r, begin, end);
+}
+
+Parser::Parser() :
+  m_symbols(new parser::Symbols),
+  m_position_handler(new position_handler<iterator_type>),
+  m_skipper(new parser::skipper<iterator_type>)
+{
+  // The grammar binds the symbol tables of the current session.
+  AnalysisSession session(*m_symbols);
+  m_grammar.reset(new parser::grammar_cppmem<iterator_type>(*m_position_handler));
+}
+
+Parser::~Parser()
+{
+  m_grammar.reset();
+  delete m_symbols;
+}
+
+bool Parser::parse(char const* filename, iterator_type& begin, iterator_type const& end, ast::cppmem& out)
+{
+  ASSERT(&parser::Symbols::instance() == m_symbols);
+  // The grammar holds copies of m_position_handler, which share the input with it.
+  m_position_handler->reset(filename, begin, end);
+  bool r = parser::qi::phrase_parse(begin, end, *m_grammar, *m_skipper, out);
+  return check_parse_result(r, begin, end);
+}
+
 } // namespace cppmem
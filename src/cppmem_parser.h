@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 namespace ast {
@@ -8,9 +9,43 @@ struct cppmem;
 
 template<typename Iterator> struct position_handler;
 
+namespace parser {
+class Symbols;
+template<typename Iterator> class grammar_cppmem;
+template<typename Iterator> struct skipper;
+} // namespace parser
+
 namespace cppmem {
 
-using iterator_type = std::string::const_iterator;
+using iterator_type = char const*;           // The parser works directly on the (mapped) input file.
 bool parse(iterator_type& begin, iterator_type const& end, position_handler<iterator_type>& handler, ast::cppmem& out);
 
+// A parser that constructs its grammar only once, to be reused for many inputs.
+//
+// The grammar refers to the symbol tables of the parser, therefore those are
+// owned by the Parser: every input must be parsed while an AnalysisSession
+// that was constructed with symbols() is current.
+//
+class Parser
+{
+ private:
+  parser::Symbols* const m_symbols;             // The symbol tables used by m_grammar.
+  std::unique_ptr<position_handler<iterator_type>> m_position_handler;
+  std::unique_ptr<parser::skipper<iterator_type>> m_skipper;
+  std::unique_ptr<parser::grammar_cppmem<iterator_type>> m_grammar;
+
+ public:
+  Parser();
+  ~Parser();
+
+  // Parse [begin, end) with filename used in diagnostics.
+  bool parse(char const* filename, iterator_type& begin, iterator_type const& end, ast::cppmem& out);
+
+  // The symbol tables to pass to the AnalysisSession.
+  parser::Symbols& symbols() const { return *m_symbols; }
+
+  // The position handler of the last parsed input.
+  position_handler<iterator_type>& get_position_handler() const { return *m_position_handler; }
+};
+
 } // namespace cppmem
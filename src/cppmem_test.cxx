@@ -5,14 +5,36 @@
 #include "sys.h"
 #include "debug.h"
 #include "grammar_unittest.h"
+#include "AnalysisSession.h"
+#include "cppmem_analyzer.h"
+#include "cppmem_parser.h"
+#include "SourceFile.h"
+#include "NDJSONWriter.h"
+#include "Server.h"
+#include "ResultCache.h"
+#include "ResultsArchiveReader.h"
+#include "ResultsArchiveWriter.h"
+#include "ReadFromLocationSubgraphs.h"
+#include "Graph.h"
+#include "utils/AIAlert.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/variant/get.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
 #include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
 using namespace ast;
 
 #define MIN_TEST 0
-#define MAX_TEST 24
+#define MAX_TEST 31
 
 #define type_type_int_nr                0
 #define type_type_atomic_int_nr         1
@@ -39,6 +61,13 @@ using namespace ast;
 #define type_type_bool_nr              22
 #define declarations_nr                23
 #define if_else_nr                     24
+#define analyze_clusters_nr            25
+#define analyze_coherence_nr           26
+#define analyze_reachability_nr        27
+#define ndjson_escaping_nr             28
+#define server_requests_nr             29
+#define result_cache_nr                30
+#define archive_round_trip_nr          31
 
 #if MAX_TEST < MIN_TEST
 #undef MAX_TEST
@@ -47,9 +76,10 @@ using namespace ast;
 
 void parse(std::string const& text, ast::nonterminal& out)
 {
-  using iterator_type = std::string::const_iterator;
-  iterator_type begin(text.begin());
-  iterator_type const end(text.end());
+  // Parse through char const*, like cppmem does, so that the grammars only need to be instantiated once.
+  using iterator_type = char const*;
+  iterator_type begin(text.data());
+  iterator_type const end(text.data() + text.size());
   parser::skipper<iterator_type> skipper;
   position_handler<iterator_type> handler("<unit_test>", begin, end);
   bool r = boost::spirit::qi::phrase_parse(begin, end, parser::grammar_unittest<iterator_type>(handler), skipper, out);
@@ -514,7 +544,7 @@ BOOST_AUTO_TEST_CASE(declarations)
   parse(text, value);
 
   BOOST_REQUIRE_EQUAL(NT_cppmem, value.which());
-  ast::cppmem prog(boost::get<cppmem>(value));
+  ast::cppmem prog(boost::get<ast::cppmem>(value));
   std::stringstream ss;
   ss << prog;
   //std::cout << "prog = \"" << ss.str() << "\"." << std::endl;
@@ -554,11 +584,383 @@ BOOST_AUTO_TEST_CASE(if_else)
 }
 #endif
 
+#if DO_TEST(analyze_clusters)
+namespace {
+
+// All candidates of result, as the (sorted) set of rf edges of every candidate.
+std::multiset<std::vector<cppmem::RFEdge>> candidate_set(cppmem::Result const& result)
+{
+  std::multiset<std::vector<cppmem::RFEdge>> candidates;
+  for (cppmem::Execution const& execution : result.executions)
+  {
+    std::vector<cppmem::RFEdge> rf{execution.rf};
+    std::sort(rf.begin(), rf.end());
+    candidates.insert(std::move(rf));
+  }
+  return candidates;
+}
+
+} // namespace
+
+// Enumerating the rf subgraphs of independent clusters of locations separately
+// must find the same candidates as enumerating all locations together.
+BOOST_AUTO_TEST_CASE(analyze_clusters)
+{
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.parser = &parser;
+
+  int tests = 0;
+  for (auto const& entry : std::filesystem::directory_iterator(CPPMEM_BENCH_DIR))
+  {
+    if (entry.path().extension() != ".c")
+      continue;
+    std::string const filepath = entry.path().string();
+    BOOST_TEST_CONTEXT(filepath)
+    {
+      SourceFile source_file(filepath.c_str());
+      BOOST_REQUIRE(source_file.is_open());
+      options.filename = filepath.c_str();
+
+      options.cluster_locations = true;
+      options.collect_executions = true;
+      cppmem::Result const clustered = cppmem::analyze(source_file.view(), options);
+      options.cluster_locations = false;
+      cppmem::Result const unclustered = cppmem::analyze(source_file.view(), options);
+      // Without collecting the executions, the counts can be calculated as a product over the clusters.
+      options.cluster_locations = true;
+      options.collect_executions = false;
+      cppmem::Result const counted = cppmem::analyze(source_file.view(), options);
+
+      BOOST_REQUIRE(clustered.success && unclustered.success && counted.success);
+      BOOST_CHECK_EQUAL(unclustered.statistics.location_clusters, std::min<size_t>(unclustered.statistics.locations_with_rf, 1));
+      BOOST_CHECK_EQUAL(clustered.statistics.candidates, unclustered.statistics.candidates);
+      BOOST_CHECK_EQUAL(clustered.statistics.distinct_graphs, unclustered.statistics.distinct_graphs);
+      BOOST_CHECK(candidate_set(clustered) == candidate_set(unclustered));
+      BOOST_CHECK_EQUAL(counted.statistics.candidates, clustered.statistics.candidates);
+      BOOST_CHECK_EQUAL(counted.statistics.distinct_graphs, clustered.statistics.distinct_graphs);
+    }
+    ++tests;
+  }
+  BOOST_CHECK(tests > 0);
+}
+#endif
+
+#if DO_TEST(analyze_coherence)
+// The coherence pre-check of ReadFromLocationSubgraphs rejects rf subgraphs
+// that read against the sequenced-before order, before they are enumerated.
+BOOST_AUTO_TEST_CASE(analyze_coherence)
+{
+  struct Litmus
+  {
+    char const* name;
+    char const* source;
+    size_t coherence_rejected;
+    size_t candidates;
+  };
+
+  Litmus const litmus_tests[] = {
+    // r1 == 1 && r2 == 0 is rejected (CoRR); the other three combinations remain.
+    { "CoRR",
+      "int main() { atomic_int x = 0; {{{ { x.store(1, mo_relaxed); } ||| { r1 = x.load(mo_relaxed); r2 = x.load(mo_relaxed); } }}} }",
+      1, 3 },
+    // Per reading thread, reading 1 or 2 followed by 0 is rejected: 81 - 7 * 7 = 32.
+    // The two combinations where the readers observe 1 and 2 in opposite order remain,
+    // because rejecting those requires a modification order (see ReadFromLocationSubgraphs::is_coherent).
+    { "CoRR2",
+      "int main() { atomic_int x = 0; {{{ { x.store(1, mo_relaxed); } ||| { x.store(2, mo_relaxed); } ||| "
+        "{ r1 = x.load(mo_relaxed); r2 = x.load(mo_relaxed); } ||| { r3 = x.load(mo_relaxed); r4 = x.load(mo_relaxed); } }}} }",
+      32, 49 },
+    // r1 can't read 0 (CoWR) and r2 can't read 2 (CoRW): ReadFromLoop never generates
+    // those rf edges, so nothing is left to reject and all four combinations remain.
+    { "CoWR+CoRW",
+      "int main() { atomic_int x = 0; {{{ { x.store(1, mo_relaxed); r1 = x.load(mo_relaxed); } ||| "
+        "{ r2 = x.load(mo_relaxed); x.store(2, mo_relaxed); } }}} }",
+      0, 4 }
+  };
+
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.parser = &parser;
+  for (Litmus const& litmus : litmus_tests)
+  {
+    BOOST_TEST_CONTEXT(litmus.name)
+    {
+      options.filename = litmus.name;
+      cppmem::Result const result = cppmem::analyze(litmus.source, options);
+      BOOST_REQUIRE(result.success);
+      BOOST_CHECK_EQUAL(result.statistics.coherence_rejected, litmus.coherence_rejected);
+      BOOST_CHECK_EQUAL(result.statistics.candidates, litmus.candidates);
+    }
+  }
+}
+#endif
+
+#if DO_TEST(analyze_reachability)
+// A ReadFromLoop caches whether its read and an unsequenced write can reach each other.
+// That depends on the Read-From edges of the previous loops, so the cached value must be
+// dropped when those change (see ReadFromLoopsPerLocation::invalidate_reachability).
+BOOST_AUTO_TEST_CASE(analyze_reachability)
+{
+  // Whichever read is enumerated first, first reads 0 and then the store of the other thread.
+  // In the latter case the store of its own thread is reachable from the other read:
+  // r2 --sb--> store(1) --rf--> r1 --sb--> store(2) (or the other way around), so the
+  // other read can't read from it. Hence r1 == 1 && r2 == 2 is never generated, which
+  // leaves three rf subgraphs; a stale cached reachability would give four.
+  char const* const source =
+      "int main() { atomic_int x = 0; {{{ { r1 = x.load(mo_relaxed); x.store(2, mo_relaxed); } ||| "
+        "{ r2 = x.load(mo_relaxed); x.store(1, mo_relaxed); } }}} }";
+
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.parser = &parser;
+  options.filename = "LB1";
+  cppmem::Result const result = cppmem::analyze(source, options);
+  BOOST_REQUIRE(result.success);
+  BOOST_CHECK_EQUAL(result.statistics.rf_subgraphs, 3u);
+  BOOST_CHECK_EQUAL(result.statistics.candidates, 3u);
+}
+#endif
+
+#if DO_TEST(ndjson_escaping)
+// Every string in an NDJSON record must be valid JSON, also when it contains control characters
+// (for example, an error message that quotes the source).
+BOOST_AUTO_TEST_CASE(ndjson_escaping)
+{
+  std::ostringstream os;
+  NDJSONWriter::write_json_string(os, std::string("\"a\\b\"\n\r\t\x01\x1f x\0", 13));
+  BOOST_CHECK_EQUAL(os.str(), "\"\\\"a\\\\b\\\"\\n\\r\\t\\u0001\\u001f x\\u0000\"");
+}
+#endif
+
+#if DO_TEST(server_requests)
+namespace {
+
+// Serve input (see Server) and return all answers; served is set to the return value of Server::serve.
+std::string serve(std::string const& input, bool& served)
+{
+  // The input and the answers are small enough to fit in a pipe.
+  int in_fds[2], out_fds[2];
+  BOOST_REQUIRE(pipe(in_fds) == 0 && pipe(out_fds) == 0);
+  BOOST_REQUIRE(write(in_fds[1], input.data(), input.size()) == static_cast<ssize_t>(input.size()));
+  close(in_fds[1]);
+  Server server;
+  served = server.serve(in_fds[0], out_fds[1]);
+  close(in_fds[0]);
+  close(out_fds[1]);
+  std::string answers;
+  char buf[4096];
+  ssize_t len;
+  while ((len = read(out_fds[0], buf, sizeof(buf))) > 0)
+    answers.append(buf, len);
+  close(out_fds[0]);
+  return answers;
+}
+
+} // namespace
+
+// Every length-prefixed request is answered with exactly one line; a malformed
+// or truncated request ends the connection with an error.
+BOOST_AUTO_TEST_CASE(server_requests)
+{
+  std::string const source1 = "int main() { int x = 0; { x = 1; } x = 2; }";
+  std::string const source2 = "int main() { atomic_int x = 0; {{{ { x.store(1, mo_relaxed); } ||| { r1 = x.load(mo_relaxed); } }}} }";
+  std::string const request1 = std::to_string(source1.size()) + '\n' + source1;
+  std::string const request2 = std::to_string(source2.size()) + '\n' + source2;
+  bool served;
+
+  std::string const answers = serve(request1 + request2 + request1, served);
+  BOOST_CHECK(served);
+  std::istringstream answer_stream(answers);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(answer_stream, line);)
+    lines.push_back(line);
+  BOOST_REQUIRE_EQUAL(lines.size(), 3u);
+  for (std::string const& line : lines)
+    BOOST_CHECK(line.compare(0, 9, "{\"exit\":0") == 0);
+  // The same request gives the same answer.
+  BOOST_CHECK_EQUAL(lines[0], lines[2]);
+  BOOST_CHECK_NE(lines[0], lines[1]);
+
+  BOOST_CHECK_EQUAL(serve("", served), "");
+  BOOST_CHECK(served);
+  BOOST_CHECK_EQUAL(serve("x\n" + source1, served), "");
+  BOOST_CHECK(!served);
+  BOOST_CHECK_EQUAL(serve(std::to_string(source1.size() + 1) + '\n' + source1, served), "");
+  BOOST_CHECK(!served);
+  // The answer to the first request is written before the second (truncated) request is read.
+  BOOST_CHECK_EQUAL(serve(request1 + request1.substr(0, 5), served), lines[0] + '\n');
+  BOOST_CHECK(!served);
+}
+#endif
+
+#if DO_TEST(result_cache)
+// A stored result is found again, without leaving temporary files behind;
+// an entry of another tool version is ignored.
+BOOST_AUTO_TEST_CASE(result_cache)
+{
+  std::filesystem::path const directory = std::filesystem::temp_directory_path() / ("cppmem_test_cache." + std::to_string(getpid()));
+  std::filesystem::remove_all(directory);
+
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.parser = &parser;
+  options.filename = "CoRR";
+  cppmem::Result const result = cppmem::analyze(
+      "int main() { atomic_int x = 0; {{{ { x.store(1, mo_relaxed); } ||| { r1 = x.load(mo_relaxed); r2 = x.load(mo_relaxed); } }}} }", options);
+  BOOST_REQUIRE(result.success);
+  std::ostringstream record;
+  NDJSONWriter ndjson_writer(record);
+  ndjson_writer.write_result(result);
+
+  ResultCache cache(directory.string());
+  std::string const ast_hash = "0123456789abcdef";
+  ResultCache::Entry entry;
+  BOOST_CHECK(!cache.lookup(ast_hash, entry));
+  cache.store(ast_hash, result);
+  BOOST_REQUIRE(cache.lookup(ast_hash, entry));
+  BOOST_CHECK_EQUAL(entry.candidates, static_cast<int>(result.statistics.candidates));
+  BOOST_CHECK_EQUAL(entry.distinct_graphs, static_cast<int>(result.statistics.distinct_graphs));
+  BOOST_CHECK_EQUAL(entry.unsequenced_races, static_cast<int>(result.unsequenced_races.size()));
+  BOOST_CHECK_EQUAL(entry.record + '\n', record.str());
+
+  // The temporary file was renamed; storing again replaces the entry.
+  cache.store(ast_hash, result);
+  std::vector<std::string> filenames;
+  for (auto const& file : std::filesystem::directory_iterator(directory))
+    filenames.push_back(file.path().filename().string());
+  BOOST_REQUIRE_EQUAL(filenames.size(), 1u);
+  BOOST_CHECK_EQUAL(filenames[0], ast_hash);
+
+  // Change the version of the entry.
+  std::string contents;
+  {
+    std::ifstream file(directory / ast_hash);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  std::string const header = std::string("cppmem-cache ") + ResultCache::tool_version() + '\n';
+  BOOST_REQUIRE(contents.compare(0, header.size(), header) == 0);
+  {
+    std::ofstream file(directory / ast_hash);
+    file << "cppmem-cache " << ResultCache::tool_version() << ".old\n" << contents.substr(header.size());
+  }
+  BOOST_CHECK(!cache.lookup(ast_hash, entry));
+  // Which is then overwritten by the next store.
+  cache.store(ast_hash, result);
+  BOOST_CHECK(cache.lookup(ast_hash, entry));
+
+  std::filesystem::remove_all(directory);
+}
+#endif
+
+#if DO_TEST(archive_round_trip)
+namespace {
+
+// Write a results archive, like cppmem --archive does, and remember what was written.
+class ArchiveObserver : public cppmem::AnalysisObserver
+{
+ private:
+  std::string m_filename;                               // The archive to write.
+  std::unique_ptr<ResultsArchiveWriter> m_archive;
+
+ public:
+  std::vector<size_t> m_number_of_subgraphs;            // The number of rf subgraphs of every location.
+  std::vector<std::vector<int>> m_subgraph_indices;     // The subgraph index of every location, of every candidate.
+
+  ArchiveObserver(std::string const& filename) : m_filename(filename) { }
+
+  void witnesses_start(Graph& graph, TopologicalOrderedActions const& topological_ordered_actions,
+      utils::Vector<ReadFromLocationSubgraphs, RFLocation> const& read_from_location_subgraphs_vector,
+      std::vector<cppmem::UnsequencedRace> const& UNUSED_ARG(unsequenced_races)) override
+  {
+    graph.cache_dot_prefix(topological_ordered_actions);
+    m_archive.reset(new ResultsArchiveWriter(m_filename));
+    m_archive->write_opsem(graph);
+    for (ReadFromLocationSubgraphs const& read_from_location_subgraphs : read_from_location_subgraphs_vector)
+    {
+      m_archive->add_location(read_from_location_subgraphs);
+      m_number_of_subgraphs.push_back(read_from_location_subgraphs.size());
+    }
+  }
+
+  void candidate(Graph& UNUSED_ARG(graph), cppmem::Execution const& execution, RFLocationSubgraphIndices const& subgraph_indices,
+      boolean::Expression const& valid, boolean::Expression const& UNUSED_ARG(loop_condition)) override
+  {
+    m_archive->add_candidate(execution.candidate, subgraph_indices, valid,
+        execution.same_as != execution.candidate ? results_archive::candidate_duplicate : 0);
+    m_subgraph_indices.emplace_back();
+    for (RFLocation location = subgraph_indices.ibegin(); location != subgraph_indices.iend(); ++location)
+      m_subgraph_indices.back().push_back(subgraph_indices[location]);
+  }
+
+  void finish()
+  {
+    m_archive->finish();
+    m_archive.reset();
+  }
+};
+
+} // namespace
+
+// Everything that is written to a results archive can be read back.
+BOOST_AUTO_TEST_CASE(archive_round_trip)
+{
+  std::filesystem::path const filepath = std::filesystem::temp_directory_path() / ("cppmem_test." + std::to_string(getpid()) + ".archive");
+
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.parser = &parser;
+  options.filename = "MP";
+  ArchiveObserver observer(filepath.string());
+  options.observer = &observer;
+  cppmem::Result const result = cppmem::analyze(
+      "int main() { atomic_int x = 0; atomic_int y = 0; {{{ { x.store(1, mo_relaxed); y.store(1, mo_release); } ||| "
+        "{ r1 = y.load(mo_acquire); r2 = x.load(mo_relaxed); } }}} }", options);
+  BOOST_REQUIRE(result.success);
+  observer.finish();
+
+  {
+    ResultsArchiveReader reader(filepath.string());
+    BOOST_REQUIRE_EQUAL(reader.number_of_candidates(), result.executions.size());
+    BOOST_REQUIRE_EQUAL(reader.number_of_locations(), observer.m_number_of_subgraphs.size());
+    for (size_t location = 0; location < reader.number_of_locations(); ++location)
+    {
+      BOOST_REQUIRE_EQUAL(reader.number_of_subgraphs(location), observer.m_number_of_subgraphs[location]);
+      for (size_t subgraph = 0; subgraph < reader.number_of_subgraphs(location); ++subgraph)
+        reader.subgraph_valid(location, subgraph);
+    }
+    for (size_t index = 0; index < reader.number_of_candidates(); ++index)
+    {
+      cppmem::Execution const& execution{result.executions[index]};
+      BOOST_CHECK_EQUAL(reader.record(index).m_candidate, static_cast<uint32_t>(execution.candidate));
+      BOOST_CHECK_EQUAL((reader.record(index).m_flags & results_archive::candidate_duplicate) != 0, execution.same_as != execution.candidate);
+      for (size_t location = 0; location < reader.number_of_locations(); ++location)
+        BOOST_CHECK_EQUAL(reader.subgraph_index(index, location), static_cast<uint32_t>(observer.m_subgraph_indices[index][location]));
+      std::ostringstream dot;
+      reader.write_dot(dot, index);
+      BOOST_CHECK(dot.str().size() > 2 && dot.str().compare(dot.str().size() - 2, 2, "}\n") == 0);
+    }
+  }
+
+  // Anything else is rejected.
+  {
+    std::ofstream file(filepath);
+    file << "Not a results archive.\n";
+  }
+  BOOST_CHECK_THROW(ResultsArchiveReader reader(filepath.string()), AIAlert::Error);
+
+  std::filesystem::remove(filepath);
+}
+#endif
+
 int BOOST_TEST_CALL_DECL
 main( int argc, char* argv[] )
 {
   Debug(NAMESPACE_DEBUG::init());
 
+  // The parser stores its symbols in the current session.
+  AnalysisSession session;
+
   return ::boost::unit_test::unit_test_main( &init_unit_test, argc, argv );
 }
 
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace ast {
+struct declaration_statement;
+struct statement_seq;
+} // namespace ast
+
+// Execute the abstract syntax tree of a cppmem program, generating the opsem graph
+// (all Action nodes with their Sequenced-Before and Additionally-Synchronizes-With edges)
+// in the Context of the current AnalysisSession.
+
+// Execute a (global) declaration.
+void execute_declaration(ast::declaration_statement const& declaration_statement);
+
+// Execute the body of function `name'.
+void execute_body(std::string name, ast::statement_seq const& body);
@@ -524,4 +524,4 @@ grammar_cppmem<Iterator>::grammar_cppmem(position_handler<Iterator>& handler) :
 } // namespace parser
 
 // Instantiate grammar template.
-template class parser::grammar_cppmem<std::string::const_iterator>;
+template class parser::grammar_cppmem<char const*>;
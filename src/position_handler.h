@@ -22,18 +22,29 @@ struct position_handler
   struct result { typedef void type; };
 
   position_handler(char const* filename, Iterator first, Iterator last) :
-      m_filename(filename), first(first), last(last), m_iters(std::make_shared<std::vector<Iterator>>())
+      m_input(std::make_shared<Input>(Input{filename, first, last})), m_iters(std::make_shared<std::vector<Iterator>>())
   {
     parser::Symbols::instance().reset();
   }
 
+  // Construct a handler without input; reset() must be called before it is used.
+  position_handler() : m_input(std::make_shared<Input>(Input{"", Iterator{}, Iterator{}})), m_iters(std::make_shared<std::vector<Iterator>>()) { }
+
+  // Start parsing a new input. Also applies to all copies of this handler.
+  void reset(char const* filename, Iterator first, Iterator last)
+  {
+    *m_input = Input{filename, first, last};
+    m_iters->clear();
+    parser::Symbols::instance().reset();
+  }
+
   boost::iterator_range<Iterator> get_line_and_range(Iterator pos, int& line, int& col) const
   {
     // Find start of current line, line- and column number;
     line = 1;
     col = 1;
-    Iterator line_start = first;
-    Iterator current = first;
+    Iterator line_start = m_input->first;
+    Iterator current = m_input->first;
     while (current != pos)
     {
       bool eol = false;
@@ -69,7 +80,7 @@ struct position_handler
     }
     // Find end of current line.
     Iterator line_end = pos;
-    while (line_end != last && *line_end != '\r' && *line_end != '\n')
+    while (line_end != m_input->last && *line_end != '\r' && *line_end != '\n')
       ++line_end;
     return { line_start, line_end };
   }
@@ -85,7 +96,7 @@ struct position_handler
   {
     int line, col;
     boost::iterator_range<Iterator> range{get_line_and_range(err_pos, line, col)};
-    if (err_pos != last)
+    if (err_pos != m_input->last)
     {
       std::cout << message << what << " line " << line << ':' << std::endl;
       show(std::cout, range, col);
@@ -113,7 +124,7 @@ struct position_handler
     int line, col;
     get_line_and_range(pos, line, col);
     std::stringstream ss;
-    ss << m_filename << ':' << line << ':' << col;
+    ss << m_input->m_filename << ':' << line << ':' << col;
     return ss.str();
   }
 
@@ -205,8 +216,14 @@ struct position_handler
     Debug(show(dc::poshandler, pos));
   }
 
-  char const* const m_filename;
-  Iterator const first;
-  Iterator const last;
+  // The input that is being parsed. Shared with all copies of this handler (the grammar stores copies).
+  struct Input
+  {
+    char const* m_filename;
+    Iterator first;
+    Iterator last;
+  };
+
+  std::shared_ptr<Input> m_input;
   std::shared_ptr<std::vector<Iterator>> m_iters;
 };
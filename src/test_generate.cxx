@@ -0,0 +1,258 @@
+#include "sys.h"
+#include "debug.h"
+#include "cppmem_analyzer.h"
+#include "cppmem_parser.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+// Generate families of tests and analyze them, to find scaling cliffs.
+//
+// Every parameter is given as a single value or as an inclusive range
+// (for example --threads 2-4); all combinations of the given values are
+// generated, `samples' random tests each. The tests are analyzed with
+// cppmem::analyze and one CSV line is written per test with its
+// parameters, the number of candidates and the analysis time. Because a
+// branch is only emitted after an earlier load in the same thread, the
+// emitted_branches column can be less than the requested branches.
+//
+// Use --write <directory> to also write the tests to disk (for example
+// to run them with cppmem --batch-dir <directory>).
+
+namespace {
+
+struct Range
+{
+  int first;
+  int last;
+};
+
+// The memory orders that an access can use.
+enum OrderClass
+{
+  order_relaxed,        // mo_relaxed.
+  order_rel_acq,        // mo_release for stores, mo_acquire for loads.
+  order_seq_cst         // mo_seq_cst.
+};
+
+char const* const order_class_names[] = { "relaxed", "rel_acq", "seq_cst" };
+
+// The parameters of one generated test.
+struct Parameters
+{
+  int threads;                          // The number of threads.
+  int actions;                          // The number of loads and stores per thread.
+  int locations;                        // The number of (atomic) memory locations.
+  int branches;                         // The number of accesses that are executed conditionally.
+  int mutexes;                          // The number of threads that run their whole body with a mutex locked.
+  std::vector<OrderClass> orders;       // The memory orders to choose from.
+};
+
+// The maximum number of actions that the analysis supports (see ActionSet).
+int constexpr max_actions = 64;
+
+// Generate a random test with the given parameters.
+// A conditional access needs an earlier load in the same thread to depend on; if there is none, the access
+// is emitted unconditionally. The number of accesses that are actually conditional is returned in emitted_branches.
+std::string generate(Parameters const& parameters, std::mt19937& random, int& emitted_branches)
+{
+  std::ostringstream out;
+  auto uniform = [&](int n){ return std::uniform_int_distribution<int>(0, n - 1)(random); };
+
+  if (parameters.mutexes > 0)
+    out << "std::mutex m;\n\n";
+  out << "int main()\n{\n";
+  for (int location = 0; location < parameters.locations; ++location)
+    out << "  atomic_int x" << location << " = 0;\n";
+
+  // Choose which accesses are conditional.
+  int const total_actions = parameters.threads * parameters.actions;
+  std::vector<bool> conditional(total_actions, false);
+  for (int branch = 0; branch < parameters.branches && branch < total_actions; ++branch)
+  {
+    int action;
+    do
+      action = uniform(total_actions);
+    while (conditional[action]);
+    conditional[action] = true;
+  }
+
+  emitted_branches = 0;
+  int next_register = 1;
+  std::vector<int> next_value(parameters.locations, 1);
+  out << "  {{{\n";
+  for (int thread = 0; thread < parameters.threads; ++thread)
+  {
+    if (thread > 0)
+      out << "  |||\n";
+    out << "    {\n";
+    bool const locked = thread < parameters.mutexes;
+    if (locked)
+      out << "      m.lock();\n";
+    int last_register = 0;      // The register of the last load of this thread, if any.
+    for (int action = 0; action < parameters.actions; ++action)
+    {
+      int const location = uniform(parameters.locations);
+      OrderClass const order_class = parameters.orders[uniform(parameters.orders.size())];
+      bool const is_store = uniform(2) == 0;
+      out << "      ";
+      // A branch needs an earlier load in the same thread to depend on.
+      if (conditional[thread * parameters.actions + action] && last_register > 0)
+      {
+        out << "if (r" << last_register << " == 1) ";
+        ++emitted_branches;
+      }
+      if (is_store)
+      {
+        out << 'x' << location << ".store(" << next_value[location]++;
+        if (order_class != order_seq_cst)
+          out << ", " << (order_class == order_relaxed ? "mo_relaxed" : "mo_release");
+        out << ");\n";
+      }
+      else
+      {
+        last_register = next_register++;
+        out << 'r' << last_register << " = x" << location << ".load(";
+        if (order_class != order_seq_cst)
+          out << (order_class == order_relaxed ? "mo_relaxed" : "mo_acquire");
+        out << ");\n";
+      }
+    }
+    if (locked)
+      out << "      m.unlock();\n";
+    out << "    }\n";
+  }
+  out << "  }}}\n}\n";
+  return out.str();
+}
+
+bool parse_range(char const* str, Range& range)
+{
+  char* end;
+  range.first = range.last = std::strtol(str, &end, 10);
+  if (*end == '-')
+    range.last = std::strtol(end + 1, &end, 10);
+  return *end == 0 && range.first >= 0 && range.first <= range.last;
+}
+
+bool parse_orders(std::string const& str, std::vector<OrderClass>& orders)
+{
+  orders.clear();
+  std::istringstream iss(str);
+  std::string name;
+  while (std::getline(iss, name, ','))
+  {
+    int order_class = 0;
+    while (order_class < 3 && name != order_class_names[order_class])
+      ++order_class;
+    if (order_class == 3)
+      return false;
+    orders.push_back(static_cast<OrderClass>(order_class));
+  }
+  return !orders.empty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Debug(NAMESPACE_DEBUG::init());
+
+  Range threads{2, 2};
+  Range actions{2, 2};
+  Range locations{2, 2};
+  Range branches{0, 0};
+  Range mutexes{0, 0};
+  std::string orders_str = "relaxed,rel_acq,seq_cst";
+  int samples = 1;
+  unsigned int seed = 1;
+  char const* write_directory = nullptr;
+  bool usage_error = false;
+  for (int arg = 1; arg < argc && !usage_error; ++arg)
+  {
+    std::string const argument{argv[arg]};
+    if (arg + 1 == argc)
+      usage_error = true;
+    else if (argument == "--threads")
+      usage_error = !parse_range(argv[++arg], threads) || threads.first < 1;
+    else if (argument == "--actions")
+      usage_error = !parse_range(argv[++arg], actions) || actions.first < 1;
+    else if (argument == "--locations")
+      usage_error = !parse_range(argv[++arg], locations) || locations.first < 1;
+    else if (argument == "--branches")
+      usage_error = !parse_range(argv[++arg], branches);
+    else if (argument == "--mutexes")
+      usage_error = !parse_range(argv[++arg], mutexes);
+    else if (argument == "--orders")
+      orders_str = argv[++arg];
+    else if (argument == "--samples")
+      usage_error = (samples = std::atoi(argv[++arg])) <= 0;
+    else if (argument == "--seed")
+      seed = std::strtoul(argv[++arg], nullptr, 10);
+    else if (argument == "--write")
+      write_directory = argv[++arg];
+    else
+      usage_error = true;
+  }
+  Parameters parameters;
+  if (usage_error || !parse_orders(orders_str, parameters.orders))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--threads N[-M]] [--actions N[-M]] [--locations N[-M]] [--branches N[-M]] [--mutexes N[-M]]\n"
+                 "       [--orders relaxed,rel_acq,seq_cst] [--samples N] [--seed N] [--write <directory>]\n";
+    return 1;
+  }
+
+  std::mt19937 random(seed);
+  cppmem::Parser parser;
+  cppmem::Options options;
+  options.collect_executions = false;
+  options.parser = &parser;
+
+  // The orders column uses '+' as separator.
+  std::string orders_column = orders_str;
+  std::replace(orders_column.begin(), orders_column.end(), ',', '+');
+
+  std::cout << "threads,actions,locations,orders,branches,mutexes,sample,emitted_branches,status,candidates,distinct,seconds\n";
+  for (parameters.threads = threads.first; parameters.threads <= threads.last; ++parameters.threads)
+    for (parameters.actions = actions.first; parameters.actions <= actions.last; ++parameters.actions)
+      for (parameters.locations = locations.first; parameters.locations <= locations.last; ++parameters.locations)
+        for (parameters.branches = branches.first; parameters.branches <= branches.last; ++parameters.branches)
+          for (parameters.mutexes = mutexes.first; parameters.mutexes <= std::min(mutexes.last, parameters.threads); ++parameters.mutexes)
+            for (int sample = 0; sample < samples; ++sample)
+            {
+              std::ostringstream name;
+              name << "gen_t" << parameters.threads << "_a" << parameters.actions << "_l" << parameters.locations <<
+                  "_b" << parameters.branches << "_m" << parameters.mutexes << "_s" << sample;
+              std::cout << parameters.threads << ',' << parameters.actions << ',' << parameters.locations << ',' <<
+                  orders_column << ',' << parameters.branches << ',' << parameters.mutexes << ',' << sample << ',';
+
+              // Every access, the initialization of every location and every lock/unlock is an action.
+              if (parameters.threads * (parameters.actions + 2) + parameters.locations > max_actions)
+              {
+                std::cout << ",too_large,,,\n";
+                continue;
+              }
+
+              int emitted_branches;
+              std::string const source = generate(parameters, random, emitted_branches);
+              std::cout << emitted_branches << ',';
+              std::string const filename = name.str() + ".c";
+              if (write_directory)
+                std::ofstream(std::string(write_directory) + '/' + filename) << source;
+
+              options.filename = filename.c_str();
+              auto const start = std::chrono::steady_clock::now();
+              cppmem::Result const result = cppmem::analyze(source, options);
+              double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+              if (result.success)
+                std::cout << "ok," << result.statistics.candidates << ',' << result.statistics.distinct_graphs << ',' << seconds << std::endl;
+              else
+                std::cout << "failed,,," << seconds << std::endl;
+            }
+}